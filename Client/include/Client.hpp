@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Packet.hpp"
+#include "WireProtocol.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/bind/bind.hpp>
@@ -65,7 +66,7 @@ namespace RType {
 
     class Client {
     public:
-        Client(boost::asio::io_context& io_context, const std::string& host, short server_port, short client_port);
+        Client(boost::asio::io_context& io_context, const std::string& host, short server_port, short client_port, uint32_t matchId = 0);
         ~Client();
         void send(const std::string& message);
         void start_receive();
@@ -84,9 +85,10 @@ namespace RType {
         void drawSprites(sf::RenderWindow& window);
         void updateSpritePosition(Frame &frame);
         void UpdateGameStateLayers();
-        void parseMessage(std::string packet_data);
-        void parseFramePacket(const std::string& packet_data);
-        void parseGameStatePacket(const std::string& packet_data);
+        void parseMessage(const std::string& packet_data);
+        void parseFramePacket(const Network::Wire::Header& header, const uint8_t* data);
+        void parseGameStatePacket(const Network::EntityRecord& record);
+        bool parseEntities(const Network::Wire::Header& header, const uint8_t* data, Frame& frame);
         void destroySprite(Frame &frame);
         void checkWinCondition(Frame& frame);
         void processEvents(sf::RenderWindow& window);
@@ -111,12 +113,14 @@ namespace RType {
         std::unordered_map<SpriteType, sf::Texture> textures_;
         std::vector<PacketElement> packets;
         std::map<int, Frame> frameMap;
+        std::map<uint32_t, std::vector<Network::EntityState>> snapshots;
         PacketElement gameStatePacket;
         sf::Clock frameClock;
         sf::Clock packetLossClock;
         int packetLossCount = 0;
         int currentFrameIndex = -1;
         int last_received_frame_id = -1;
+        uint32_t matchId_ = 0;
         bool winGame = false;
         const sf::Time frameDuration = sf::milliseconds(10);
         const sf::Time packetLossDuration = sf::seconds(10);
@@ -18,18 +18,19 @@ void signalHandler(int signum) {
 
 int main(int ac, char **av)
 {
-    if (ac != 4) {
-        std::cerr << "Usage: " << av[0] << " <host> <server-port> <client-port>" << std::endl;
+    if (ac != 4 && ac != 5) {
+        std::cerr << "Usage: " << av[0] << " <host> <server-port> <client-port> [match-id]" << std::endl;
         return 84;
     }
 
     std::string host = av[1];
     short server_port = std::stoi(av[2]);
     short client_port = std::stoi(av[3]);
+    uint32_t match_id = ac == 5 ? std::stoul(av[4]) : 0;
 
     try {
         boost::asio::io_context io_context;
-        RType::Client client(io_context, host, server_port, client_port);
+        RType::Client client(io_context, host, server_port, client_port, match_id);
 
         std::signal(SIGINT, signalHandler);
         client.main_loop();
@@ -9,12 +9,13 @@
 #include "DataPacking.hpp"
 
 #include <string>
+#include <algorithm>
 #include <X11/Xlibint.h>
 
 using boost::asio::ip::udp;
 
-RType::Client::Client(boost::asio::io_context& io_context, const std::string& host, short server_port, short client_port)
-    : socket_(io_context, udp::endpoint(udp::v4(), client_port)), io_context_(io_context), window(sf::VideoMode(1280, 720), "R-Type Client"), send_timer_(io_context) // Initialize send_timer_
+RType::Client::Client(boost::asio::io_context& io_context, const std::string& host, short server_port, short client_port, uint32_t matchId)
+    : socket_(io_context, udp::endpoint(udp::v4(), client_port)), io_context_(io_context), window(sf::VideoMode(1280, 720), "R-Type Client"), send_timer_(io_context), matchId_(matchId) // Initialize send_timer_
 {
     udp::resolver resolver(io_context);
     udp::resolver::query query(udp::v4(), host, std::to_string(server_port));
@@ -181,126 +182,134 @@ void RType::Client::drawSprites(sf::RenderWindow& window)
         window.draw(winText);
 }
 
-void RType::Client::parseMessage(std::string packet_data)
+void RType::Client::parseMessage(const std::string& packet_data)
 {
-    if (packet_data.empty()) {
-        std::cerr << "[ERROR] Empty packet data." << std::endl;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(packet_data.data());
+    Network::Wire::Header header;
+
+    if (!Network::Wire::decodeHeader(data, packet_data.size(), header)) {
+        std::cerr << "[ERROR] Invalid datagram of " << packet_data.size() << " bytes." << std::endl;
         return;
     }
-
-    if (packet_data.find(':') != std::string::npos) {
-        parseFramePacket(packet_data);
+    if (header.type == Network::PacketType::FRAME) {
+        parseFramePacket(header, data);
+    } else if (header.count == 1) {
+        parseGameStatePacket(Network::Wire::decodeRecord(data, 0));
     } else {
-        parseGameStatePacket(packet_data);
+        std::cerr << "[ERROR] Invalid game state packet with " << header.count << " records." << std::endl;
     }
 }
 
-void RType::Client::parseFramePacket(const std::string& packet_data)
+void RType::Client::parseFramePacket(const Network::Wire::Header& header, const uint8_t* data)
 {
-    std::stringstream ss(packet_data);
-    std::string frame_segment;
-
-    std::getline(ss, frame_segment, ':');
-    int frame_id;
-    try {
-        frame_id = std::stoi(frame_segment);
-    } catch (const std::exception& e) {
-        std::cerr << "[ERROR] Invalid Frame ID format: " << frame_segment << std::endl;
-        return;
-    }
-
+    int frame_id = static_cast<int>(header.frameId);
     Frame new_frame;
     new_frame.frameId = frame_id;
+    new_frame.entityPackets.reserve(header.count);
 
-    if (ss.eof()) {
-        mutex_frameMap.lock();
-        frameMap.emplace(frame_id, new_frame);
-        mutex_frameMap.unlock();
-        return;
-    }
-
-    while (std::getline(ss, frame_segment, '/')) {
-        std::vector<std::string> elements;
-        std::stringstream packet_ss(frame_segment);
-        std::string segment;
-
-        while (std::getline(packet_ss, segment, ';')) {
-            elements.push_back(segment);
-        }
-
-        if (elements.size() != 4) {
-            std::cerr << "[ERROR] Invalid subpacket format: " << frame_segment << std::endl;
-            continue;
-        }
-
-        try {
-            PacketElement packetElement;
-            uint8_t packet_type = static_cast<uint8_t>(frame_segment[0]);
-            packetElement.action = static_cast<int>(packet_type);
-            packetElement.server_id = std::stoi(elements[1]);
-            packetElement.new_x = std::stof(elements[2]);
-            packetElement.new_y = std::stof(elements[3]);
-
-            if (packetElement.action == 33) {
-                send_queue_.push(createPacket(Network::PacketType::IMPORTANT_PACKET_RECEIVED) + ";" + std::to_string(frame_id));
-            } else
-                new_frame.entityPackets.push_back(packetElement);
-
-        } catch (const std::exception& e) {
-            std::cerr << "[ERROR] Failed to parse subpacket: " << e.what() << std::endl;
-        }
+    for (size_t i = 0; i < header.count; ++i) {
+        Network::EntityRecord record = Network::Wire::decodeRecord(data, i);
+        PacketElement packetElement;
+        packetElement.action = static_cast<int>(record.type);
+        packetElement.server_id = record.id;
+        packetElement.new_x = record.x;
+        packetElement.new_y = record.y;
+
+        if (record.type == Network::PacketType::IMPORTANT_PACKET) {
+            send_queue_.push(createPacket(Network::PacketType::IMPORTANT_PACKET_RECEIVED) + ";" + std::to_string(frame_id));
+        } else
+            new_frame.entityPackets.push_back(packetElement);
     }
+    if (Network::Wire::hasEntities(header) && parseEntities(header, data, new_frame))
+        send_queue_.push(createPacket(Network::PacketType::FRAME_ACK) + ";" + std::to_string(frame_id));
 
     packetLossCount = frame_id - (last_received_frame_id + 1);
     mutex_last_received_frame_id.lock();
     last_received_frame_id = frame_id;
     mutex_last_received_frame_id.unlock();
     mutex_frameMap.lock();
-    frameMap.emplace(new_frame.frameId, new_frame);
-    auto it = frameMap.find(frame_id);
-    if (it != frameMap.end()) {
-        mutex_frameMap.unlock();
-        return;
-    }
-    frameMap.emplace(new_frame.frameId, new_frame);
+    frameMap.emplace(new_frame.frameId, std::move(new_frame));
     mutex_frameMap.unlock();
 }
 
-void RType::Client::parseGameStatePacket(const std::string& packet_data)
+// Entities are a difference from a frame this client acknowledged, which may
+// be older than the frames already drawn: sprites follow the difference from
+// the newest decoded frame instead. The entities of every decoded frame are
+// kept as the baseline of the next ones.
+bool RType::Client::parseEntities(const Network::Wire::Header& header, const uint8_t* data, Frame& frame)
 {
-    std::stringstream ss(packet_data);
-    std::vector<std::string> elements;
-    std::string segment;
-
-    while (std::getline(ss, segment, ';')) {
-        elements.push_back(segment);
+    static const std::vector<Network::EntityState> noEntities;
+    auto baselineIt = snapshots.find(header.baselineId);
+    if (header.baselineId != Network::Wire::noBaseline && baselineIt == snapshots.end()) {
+        std::cerr << "[ERROR] Frame " << header.frameId << " is based on unknown frame " << header.baselineId << "." << std::endl;
+        return false;
+    }
+    const auto& baseline = header.baselineId != Network::Wire::noBaseline ? baselineIt->second : noEntities;
+    std::vector<Network::EntityState> entities = baseline;
+    Network::PositionQuantiser quantiser;
+
+    bool decoded = Network::Wire::decodeEntities(data, header, baseline.data(), baseline.size(), quantiser,
+        [&entities](Network::EntityChange change, const Network::EntityState& entity) {
+        auto it = std::lower_bound(entities.begin(), entities.end(), entity.id, [](const Network::EntityState& known, uint32_t id) {
+            return known.id < id;
+        });
+        bool known = it != entities.end() && it->id == entity.id;
+        if (change == Network::EntityChange::Removed) {
+            if (known)
+                entities.erase(it);
+        } else if (known)
+            *it = entity;
+        else
+            entities.insert(it, entity);
+    });
+    if (!decoded) {
+        std::cerr << "[ERROR] Invalid entity block in frame " << header.frameId << "." << std::endl;
+        return false;
     }
 
-    if (elements.size() != 4) {
-        std::cerr << "[ERROR] Invalid game state packet format: " << packet_data << std::endl;
-        return;
+    // A frame older than the newest decoded one arrived late and changes nothing on screen.
+    if (snapshots.empty() || snapshots.rbegin()->first < header.frameId) {
+        const auto& drawn = snapshots.empty() ? noEntities : snapshots.rbegin()->second;
+        Network::Wire::forEachDifference(entities.data(), entities.size(), drawn.data(), drawn.size(),
+            [&frame, &quantiser](const Network::EntityState* entity, const Network::EntityState* previous) {
+            const Network::EntityState& state = entity ? *entity : *previous;
+            PacketElement element{static_cast<int>(Network::PacketType::DELETE), static_cast<int>(state.id), quantiser.toX(state.x), quantiser.toY(state.y)};
+            if (!entity || !previous || entity->kind != previous->kind) {
+                // The id of a removed entity may come back as a new one.
+                if (previous)
+                    frame.entityPackets.push_back(element);
+                element.action = static_cast<int>(state.kind);
+                if (entity)
+                    frame.entityPackets.push_back(element);
+            } else {
+                element.action = static_cast<int>(Network::PacketType::CHANGE);
+                frame.entityPackets.push_back(element);
+            }
+        });
     }
+    snapshots[header.frameId] = std::move(entities);
+    while (snapshots.size() > Network::Wire::baselineHistory)
+        snapshots.erase(snapshots.begin());
+    return true;
+}
 
-    try {
-        PacketElement packetElement;
-        uint8_t packet_type = static_cast<uint8_t>(packet_data[0]);
-        packetElement.action = static_cast<int>(packet_type);
-        packetElement.server_id = std::stoi(elements[1]);
-        packetElement.new_x = std::stof(elements[2]);
-        packetElement.new_y = std::stof(elements[3]);
-
-        if (packetElement.action == 31 || packetElement.action == 3 || packetElement.action == 30) {
-            gameStatePacket = packetElement;
-        }
-        if (packetElement.action == 32) {
-            auto now = std::chrono::steady_clock::now();
-            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-            long long sentTime = packetElement.server_id;
-            long long latency = ms - sentTime;
-            latencyText.setString("Latency: " + std::to_string(latency) + " ms");
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "[ERROR] Failed to parse game state packet: " << e.what() << std::endl;
+void RType::Client::parseGameStatePacket(const Network::EntityRecord& record)
+{
+    PacketElement packetElement;
+    packetElement.action = static_cast<int>(record.type);
+    packetElement.server_id = record.id;
+    packetElement.new_x = record.x;
+    packetElement.new_y = record.y;
+
+    if (packetElement.action == 31 || packetElement.action == 3 || packetElement.action == 30) {
+        gameStatePacket = packetElement;
+    }
+    if (packetElement.action == 32) {
+        auto now = std::chrono::steady_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+        // The server sends the low 32 bits of its clock.
+        uint32_t latency = static_cast<uint32_t>(ms) - static_cast<uint32_t>(record.id);
+        latencyText.setString("Latency: " + std::to_string(latency) + " ms");
     }
 }
 
@@ -355,7 +364,7 @@ void RType::Client::updatePacketLoss() {
 int RType::Client::main_loop()
 {
     loadTextures();
-    send(createPacket(Network::PacketType::REQCONNECT));
+    send(createPacket(Network::PacketType::REQCONNECT) + ";" + std::to_string(matchId_));
     LoadSound();
     LoadFont();
 
@@ -378,13 +387,21 @@ int RType::Client::main_loop()
                 mutex_frameMap.lock();
                 auto it = frameMap.find(currentFrameIndex);
                 updatePacketLoss();
-                Frame currentFrame = it->second;
-                mutex_frameMap.unlock();
-                createSprite(currentFrame);
-                destroySprite(currentFrame);
-                updateSpritePosition(currentFrame);
-                checkWinCondition(currentFrame);
-                currentFrameIndex++;
+                if (it == frameMap.end()) {
+                    // A lost frame is skipped once a later one arrived: its
+                    // entity changes come with the next decoded frame.
+                    if (currentFrameIndex < last_received_frame_id)
+                        currentFrameIndex++;
+                    mutex_frameMap.unlock();
+                } else {
+                    Frame currentFrame = it->second;
+                    mutex_frameMap.unlock();
+                    destroySprite(currentFrame);
+                    createSprite(currentFrame);
+                    updateSpritePosition(currentFrame);
+                    checkWinCondition(currentFrame);
+                    currentFrameIndex++;
+                }
             }
             this->window.clear();
             drawSprites(window);
@@ -0,0 +1,370 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** ArchetypeRegistry
+*/
+
+#ifndef ARCHETYPEREGISTRY_H
+#define ARCHETYPEREGISTRY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Registry.hpp"
+
+namespace ecs_detail {
+    // One component type of an archetype, stored as a plain vector.
+    class column_base {
+    public:
+        virtual ~column_base() = default;
+
+        virtual std::unique_ptr<column_base> make_empty() const = 0;
+        // Appends the element at row of other, a column of the same type.
+        virtual void push_moved(column_base& other, std::size_t row) = 0;
+        virtual void swap_remove(std::size_t row) = 0;
+    };
+
+    template <typename Component>
+    class column : public column_base {
+    public:
+        std::unique_ptr<column_base> make_empty() const override { return std::make_unique<column>(); }
+
+        void push_moved(column_base& other, std::size_t row) override {
+            data.push_back(std::move(static_cast<column&>(other).data[row]));
+        }
+
+        void swap_remove(std::size_t row) override {
+            if (row + 1 != data.size()) {
+                data[row] = std::move(data.back());
+            }
+            data.pop_back();
+        }
+
+        std::vector<Component> data;
+    };
+
+    // Entities sharing one exact component signature, one column per component.
+    struct archetype {
+        std::vector<std::size_t> signature;
+        std::vector<std::unique_ptr<column_base>> columns;
+        std::vector<std::size_t> entities;
+        std::unordered_map<std::size_t, archetype*> add_edges;
+        std::unordered_map<std::size_t, archetype*> remove_edges;
+
+        // Position of a component id in signature/columns, or signature.size().
+        std::size_t column_of(std::size_t id) const {
+            auto it = std::lower_bound(signature.begin(), signature.end(), id);
+            return it != signature.end() && *it == id ? static_cast<std::size_t>(it - signature.begin()) : signature.size();
+        }
+
+        bool has(std::size_t id) const { return column_of(id) != signature.size(); }
+
+        template <typename Component>
+        std::vector<Component>& data(std::size_t col) {
+            return static_cast<column<Component>&>(*columns[col]).data;
+        }
+    };
+}
+
+template <typename World, typename... Components>
+class archetype_view;
+
+/**
+ * @brief Archetype (table) backend with the entity/component API of Registry.
+ *
+ * Entities with the same component signature share an archetype and their
+ * components sit at the same row of its columns, so a query walks the rows of
+ * the matching archetypes linearly, without probing other pools. Adding or
+ * removing a component moves the entity to the archetype of its new signature;
+ * the transitions are cached on the archetypes.
+ *
+ * Handles, spawn/kill, add/emplace/remove_component, has_component,
+ * get_component, view<...>().each() and commands() behave as in Registry, so
+ * code written against that subset runs on either backend. Views yield slot
+ * indices like Registry views. Pool access (get_components) and the system
+ * scheduler only exist on Registry.
+ */
+class ArchetypeRegistry {
+public:
+    using Entity = Registry::Entity;
+
+    static std::size_t entity_index(Entity const& e) { return Registry::entity_index(e); }
+    static std::size_t entity_generation(Entity const& e) { return Registry::entity_generation(e); }
+    static Entity make_entity(std::size_t index, std::size_t generation) { return Registry::make_entity(index, generation); }
+
+    ArchetypeRegistry() : _commands(*this) {
+        _archetypes.push_back(std::make_unique<ecs_detail::archetype>());
+    }
+    ~ArchetypeRegistry() = default;
+
+    ArchetypeRegistry(const ArchetypeRegistry&) = delete;
+    ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+
+    Entity spawn_entity() {
+        std::size_t index;
+        if (!_deadEntities.empty()) {
+            std::pop_heap(_deadEntities.begin(), _deadEntities.end(), std::greater<>());
+            index = _deadEntities.back();
+            _deadEntities.pop_back();
+        } else {
+            index = _records.size();
+            _records.push_back({});
+        }
+        ecs_detail::archetype& root = *_archetypes.front();
+        _records[index].alive = true;
+        _records[index].table = &root;
+        _records[index].row = root.entities.size();
+        root.entities.push_back(index);
+        return make_entity(index, _records[index].generation);
+    }
+
+    Entity entity_from_index(std::size_t idx) const {
+        return idx < _records.size() ? make_entity(idx, _records[idx].generation) : static_cast<Entity>(idx);
+    }
+
+    void kill_entity(Entity const& e) {
+        if (!entity_exists(e)) {
+            return;
+        }
+        std::size_t index = entity_index(e);
+        remove_row(*_records[index].table, _records[index].row);
+        _records[index].alive = false;
+        _records[index].table = nullptr;
+        ++_records[index].generation;
+        _deadEntities.push_back(index);
+        std::push_heap(_deadEntities.begin(), _deadEntities.end(), std::greater<>());
+    }
+
+    bool entity_exists(Entity const& entity) const {
+        std::size_t index = entity_index(entity);
+        return index < _records.size() && _records[index].alive && _records[index].generation == entity_generation(entity);
+    }
+
+    // Columns are created on demand; registering only makes the type known up front.
+    template <typename Component>
+    void register_component() {
+        std::size_t id = component_id<Component>();
+        if (id >= _prototypes.size()) {
+            _prototypes.resize(id + 1);
+        }
+        if (!_prototypes[id]) {
+            _prototypes[id] = std::make_unique<ecs_detail::column<Component>>();
+        }
+    }
+
+    template <typename Component>
+    std::decay_t<Component>& add_component(Entity const& to, Component&& c) {
+        return emplace_component<std::decay_t<Component>>(to, std::forward<Component>(c));
+    }
+
+    template <typename Component, typename... Params>
+    Component& emplace_component(Entity const& to, Params&&... p) {
+        if (!entity_exists(to)) {
+            throw std::out_of_range("Entity does not exist");
+        }
+        register_component<Component>();
+        std::size_t id = component_id<Component>();
+        Component value = construct<Component>(std::forward<Params>(p)...);
+        record& rec = _records[entity_index(to)];
+        std::size_t col = rec.table->column_of(id);
+        if (col != rec.table->signature.size()) {
+            return rec.table->data<Component>(col)[rec.row] = std::move(value);
+        }
+        ecs_detail::archetype& target = add_edge(*rec.table, id);
+        move_entity(entity_index(to), target);
+        std::vector<Component>& column = target.data<Component>(target.column_of(id));
+        column.push_back(std::move(value));
+        return column.back();
+    }
+
+    template <typename Component>
+    void remove_component(Entity const& from) {
+        if (!entity_exists(from)) {
+            return;
+        }
+        std::size_t id = component_id<Component>();
+        record& rec = _records[entity_index(from)];
+        if (rec.table->has(id)) {
+            move_entity(entity_index(from), remove_edge(*rec.table, id));
+        }
+    }
+
+    template <typename Component>
+    bool has_component(Entity const& entity) const {
+        return entity_exists(entity) && _records[entity_index(entity)].table->has(component_id<Component>());
+    }
+
+    template <typename Component>
+    Component& get_component(Entity const& entity) {
+        if (!has_component<Component>(entity)) {
+            throw std::out_of_range("get_component(): entity has no " + std::string(typeid(Component).name()));
+        }
+        const record& rec = _records[entity_index(entity)];
+        return rec.table->data<Component>(rec.table->column_of(component_id<Component>()))[rec.row];
+    }
+
+    template <typename... Components>
+    archetype_view<ArchetypeRegistry, Components...> view() {
+        return archetype_view<ArchetypeRegistry, Components...>(*this);
+    }
+
+    command_buffer<ArchetypeRegistry>& commands() {
+        return _commands;
+    }
+
+    void flush_commands() {
+        _commands.flush();
+    }
+
+    std::size_t archetype_count() const { return _archetypes.size(); }
+
+private:
+    template <typename World, typename... Components>
+    friend class archetype_view;
+
+    struct record {
+        ecs_detail::archetype* table = nullptr;
+        std::size_t row = 0;
+        std::uint32_t generation = 0;
+        bool alive = false;
+    };
+
+    template <typename Component, typename... Params>
+    static Component construct(Params&&... p) {
+        if constexpr (std::is_aggregate_v<Component>) {
+            return Component{std::forward<Params>(p)...};
+        } else {
+            return Component(std::forward<Params>(p)...);
+        }
+    }
+
+    ecs_detail::archetype& find_or_create(std::vector<std::size_t> const& signature) {
+        for (auto& table : _archetypes) {
+            if (table->signature == signature) {
+                return *table;
+            }
+        }
+        auto table = std::make_unique<ecs_detail::archetype>();
+        table->signature = signature;
+        for (std::size_t id : signature) {
+            table->columns.push_back(_prototypes[id]->make_empty());
+        }
+        _archetypes.push_back(std::move(table));
+        return *_archetypes.back();
+    }
+
+    ecs_detail::archetype& add_edge(ecs_detail::archetype& from, std::size_t id) {
+        auto it = from.add_edges.find(id);
+        if (it != from.add_edges.end()) {
+            return *it->second;
+        }
+        std::vector<std::size_t> signature = from.signature;
+        signature.insert(std::lower_bound(signature.begin(), signature.end(), id), id);
+        ecs_detail::archetype& to = find_or_create(signature);
+        from.add_edges[id] = &to;
+        to.remove_edges[id] = &from;
+        return to;
+    }
+
+    ecs_detail::archetype& remove_edge(ecs_detail::archetype& from, std::size_t id) {
+        auto it = from.remove_edges.find(id);
+        if (it != from.remove_edges.end()) {
+            return *it->second;
+        }
+        std::vector<std::size_t> signature = from.signature;
+        signature.erase(std::lower_bound(signature.begin(), signature.end(), id));
+        ecs_detail::archetype& to = find_or_create(signature);
+        from.remove_edges[id] = &to;
+        to.add_edges[id] = &from;
+        return to;
+    }
+
+    // Moves the components the two signatures share; a column only the target
+    // has is filled by the caller right after.
+    void move_entity(std::size_t index, ecs_detail::archetype& to) {
+        record& rec = _records[index];
+        ecs_detail::archetype& from = *rec.table;
+        for (std::size_t col = 0; col < from.signature.size(); ++col) {
+            std::size_t target = to.column_of(from.signature[col]);
+            if (target != to.signature.size()) {
+                to.columns[target]->push_moved(*from.columns[col], rec.row);
+            }
+        }
+        remove_row(from, rec.row);
+        rec.table = &to;
+        rec.row = to.entities.size();
+        to.entities.push_back(index);
+    }
+
+    void remove_row(ecs_detail::archetype& table, std::size_t row) {
+        for (auto& column : table.columns) {
+            column->swap_remove(row);
+        }
+        if (row + 1 != table.entities.size()) {
+            table.entities[row] = table.entities.back();
+            _records[table.entities[row]].row = row;
+        }
+        table.entities.pop_back();
+    }
+
+    std::vector<record> _records;
+    std::vector<std::size_t> _deadEntities;
+    std::vector<std::unique_ptr<ecs_detail::column_base>> _prototypes;
+    std::vector<std::unique_ptr<ecs_detail::archetype>> _archetypes;
+    command_buffer<ArchetypeRegistry> _commands;
+};
+
+/**
+ * @brief Query over the archetypes holding every listed component.
+ *
+ * each() takes the same functions as component_view::each(): f(index,
+ * components...) or f(components...), const components being read-only.
+ */
+template <typename World, typename... Components>
+class archetype_view {
+    static_assert(sizeof...(Components) > 0, "archetype_view needs at least one component");
+
+public:
+    using Entity = std::size_t;
+
+    explicit archetype_view(World& world) : _world(&world) {}
+
+    template <typename Function>
+    void each(Function&& f) const {
+        const std::size_t ids[] = {component_id<std::remove_const_t<Components>>()...};
+        for (auto& table : _world->_archetypes) {
+            if (table->entities.empty() || !std::all_of(std::begin(ids), std::end(ids), [&table](std::size_t id) { return table->has(id); })) {
+                continue;
+            }
+            each_row(*table, f, std::index_sequence_for<Components...>{});
+        }
+    }
+
+private:
+    template <typename Function, std::size_t... Is>
+    void each_row(ecs_detail::archetype& table, Function& f, std::index_sequence<Is...>) const {
+        auto columns = std::make_tuple(table.data<std::remove_const_t<Components>>(table.column_of(component_id<std::remove_const_t<Components>>())).data()...);
+        const std::size_t rows = table.entities.size();
+        for (std::size_t row = 0; row < rows; ++row) {
+            if constexpr (std::is_invocable_v<Function&, Entity, Components&...>) {
+                f(table.entities[row], static_cast<Components&>(std::get<Is>(columns)[row])...);
+            } else {
+                f(static_cast<Components&>(std::get<Is>(columns)[row])...);
+            }
+        }
+    }
+
+    World* _world;
+};
+
+#endif // ARCHETYPEREGISTRY_H
@@ -0,0 +1,94 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** CommandBuffer
+*/
+
+#ifndef COMMANDBUFFER_H
+#define COMMANDBUFFER_H
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Records structural changes to apply at the next sync point.
+ *
+ * Killing an entity or adding/removing a component moves elements inside
+ * dense pools, which breaks any view being iterated. Systems record those
+ * changes here instead and the Registry applies them in order in flush(),
+ * which run_systems() calls after each stage of systems.
+ * Recording is thread-safe, flushing is not. spawn() reserves the entity slot
+ * right away (no pool is touched) so the returned handle can be used in later
+ * commands; it grows the entity table, so only exclusive systems may call it.
+ */
+template <typename World>
+class command_buffer {
+public:
+    using Entity = std::size_t;
+
+    explicit command_buffer(World& world) : _world(world) {}
+
+    command_buffer(const command_buffer&) = delete;
+    command_buffer& operator=(const command_buffer&) = delete;
+
+    Entity spawn() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _world.spawn_entity();
+    }
+
+    void kill(Entity entity) {
+        record([entity](World& world) {
+            world.kill_entity(entity);
+        });
+    }
+
+    template <typename Component>
+    void add(Entity entity, Component&& component) {
+        record([entity, component = std::forward<Component>(component)](World& world) mutable {
+            if (world.entity_exists(entity)) {
+                world.add_component(entity, std::move(component));
+            }
+        });
+    }
+
+    template <typename Component>
+    void remove(Entity entity) {
+        record([entity](World& world) {
+            world.template remove_component<Component>(entity);
+        });
+    }
+
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _commands.empty();
+    }
+
+    // Applies the recorded commands in order, including the ones they record.
+    void flush() {
+        while (!_commands.empty()) {
+            std::vector<std::function<void(World&)>> pending;
+            pending.swap(_commands);
+            for (auto& command : pending) {
+                command(_world);
+            }
+        }
+    }
+
+private:
+    template <typename Command>
+    void record(Command&& command) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _commands.emplace_back(std::forward<Command>(command));
+    }
+
+    World& _world;
+    mutable std::mutex _mutex;
+    std::vector<std::function<void(World&)>> _commands;
+};
+
+#endif // COMMANDBUFFER_H
@@ -0,0 +1,121 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** ComponentPool
+*/
+
+#ifndef COMPONENTPOOL_H
+#define COMPONENTPOOL_H
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include "DenseArray.hpp"
+#include "Snapshot.hpp"
+
+/**
+ * @brief Type-erased handle on a component storage, owned by the Registry.
+ *
+ * Typed access never goes through the virtual interface: the Registry
+ * downcasts to pool_holder<storage_t<Component>> using the component id.
+ * slot_of() and swap_slots() let the Registry reorder packed pools to keep
+ * groups aligned; they are only called on dense_array pools.
+ * renumber() and shrink_to() move an entity's component to another id and
+ * trim the per-id index during Registry::compact().
+ * set_tick() and trim_removed() drive the change tracking of dense_array
+ * pools and do nothing on other storages. save() and load() copy the pool to
+ * and from a Registry snapshot; they are only called when snapshotable().
+ * load() gets the live flag of every entity slot and throws on a component of
+ * a dead or unknown entity.
+ */
+class component_pool {
+public:
+    virtual ~component_pool() = default;
+
+    virtual void erase(std::size_t entity) = 0;
+    virtual bool contains(std::size_t entity) const = 0;
+    virtual std::size_t slot_of(std::size_t entity) const = 0;
+    virtual void swap_slots(std::size_t a, std::size_t b) = 0;
+    virtual void set_tick(tick_t tick) = 0;
+    virtual void trim_removed(tick_t tick) = 0;
+    virtual void clear() = 0;
+    virtual void renumber(std::size_t from, std::size_t to) = 0;
+    virtual void shrink_to(std::size_t entityCount) = 0;
+
+    virtual bool snapshotable() const = 0;
+    virtual std::size_t component_size() const = 0;
+    virtual void save(snapshot_writer& out) const = 0;
+    virtual void load(snapshot_reader& in, const std::vector<bool>& alive) = 0;
+};
+
+namespace ecs_detail {
+    template <typename Value>
+    struct optional_value {
+        using type = Value;
+    };
+
+    template <typename Value>
+    struct optional_value<std::optional<Value>> {
+        using type = Value;
+    };
+}
+
+template <typename Storage>
+class pool_holder : public component_pool {
+public:
+    void erase(std::size_t entity) override { storage.erase(entity); }
+    bool contains(std::size_t entity) const override { return storage.contains(entity); }
+
+    std::size_t slot_of(std::size_t entity) const override {
+        if constexpr (packed) {
+            return storage.get_index(entity);
+        } else {
+            return entity;
+        }
+    }
+
+    void swap_slots(std::size_t a, std::size_t b) override {
+        if constexpr (packed) {
+            storage.swap_slots(a, b);
+        }
+    }
+
+    void set_tick(tick_t tick) override {
+        if constexpr (packed) {
+            storage.set_tick(tick);
+        }
+    }
+
+    void trim_removed(tick_t tick) override {
+        if constexpr (packed) {
+            storage.trim_removed(tick);
+        }
+    }
+
+    void clear() override { storage.clear(); }
+    void renumber(std::size_t from, std::size_t to) override { storage.renumber(from, to); }
+    void shrink_to(std::size_t entityCount) override { storage.shrink_to(entityCount); }
+
+    bool snapshotable() const override { return std::is_trivially_copyable_v<component_type>; }
+    std::size_t component_size() const override { return sizeof(component_type); }
+
+    void save(snapshot_writer& out) const override {
+        if constexpr (std::is_trivially_copyable_v<component_type>) {
+            ecs_detail::save_pool(out, storage);
+        }
+    }
+
+    void load(snapshot_reader& in, const std::vector<bool>& alive) override {
+        if constexpr (std::is_trivially_copyable_v<component_type>) {
+            ecs_detail::load_pool(in, storage, alive);
+        }
+    }
+
+    static constexpr bool packed = std::is_same_v<Storage, dense_array<typename Storage::value_type>>;
+    using component_type = std::conditional_t<packed, typename Storage::value_type, typename ecs_detail::optional_value<typename Storage::value_type>::type>;
+
+    Storage storage;
+};
+
+#endif // COMPONENTPOOL_H
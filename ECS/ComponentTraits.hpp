@@ -0,0 +1,110 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** ComponentTraits
+*/
+
+#ifndef COMPONENTTRAITS_H
+#define COMPONENTTRAITS_H
+
+#include <cstddef>
+#include <type_traits>
+#include "SparseArray.hpp"
+#include "DenseArray.hpp"
+
+/**
+ * @brief Selects the storage and the id the Registry uses for a component type.
+ *
+ * Components default to sparse_array (one optional slot per entity id).
+ * Specialize this trait with dense_array for components that are iterated
+ * every tick so that systems only walk live components.
+ *
+ * The id indexes the Registry pool table. Engine components declare a fixed
+ * id so that every module (server, dlopen'd game libraries) agrees on it;
+ * components without one get the next free id on first use.
+ */
+template <typename Component>
+struct component_traits {
+    using storage_type = sparse_array<Component>;
+};
+
+template <typename Component>
+using storage_t = typename component_traits<Component>::storage_type;
+
+constexpr std::size_t first_dynamic_component_id = 32;
+
+namespace ecs_detail {
+    template <typename Component, typename = void>
+    struct has_static_id : std::false_type {};
+
+    template <typename Component>
+    struct has_static_id<Component, std::void_t<decltype(component_traits<Component>::id)>> : std::true_type {};
+
+    inline std::size_t next_component_id() {
+        static std::size_t next = first_dynamic_component_id;
+        return next++;
+    }
+}
+
+template <typename Component>
+std::size_t component_id() {
+    if constexpr (ecs_detail::has_static_id<Component>::value) {
+        return component_traits<Component>::id;
+    } else {
+        static const std::size_t id = ecs_detail::next_component_id();
+        return id;
+    }
+}
+
+struct Position;
+struct Velocity;
+struct Drawable;
+struct Controllable;
+struct Collidable;
+struct Projectile;
+struct Collider;
+
+template <>
+struct component_traits<Position> {
+    using storage_type = dense_array<Position>;
+    static constexpr std::size_t id = 0;
+};
+
+template <>
+struct component_traits<Velocity> {
+    using storage_type = dense_array<Velocity>;
+    static constexpr std::size_t id = 1;
+};
+
+template <>
+struct component_traits<Drawable> {
+    using storage_type = dense_array<Drawable>;
+    static constexpr std::size_t id = 2;
+};
+
+template <>
+struct component_traits<Controllable> {
+    using storage_type = sparse_array<Controllable>;
+    static constexpr std::size_t id = 3;
+};
+
+template <>
+struct component_traits<Collidable> {
+    using storage_type = dense_array<Collidable>;
+    static constexpr std::size_t id = 4;
+};
+
+template <>
+struct component_traits<Projectile> {
+    using storage_type = dense_array<Projectile>;
+    static constexpr std::size_t id = 5;
+};
+
+template <>
+struct component_traits<Collider> {
+    using storage_type = dense_array<Collider>;
+    static constexpr std::size_t id = 6;
+};
+
+#endif // COMPONENTTRAITS_H
@@ -0,0 +1,79 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** Group
+*/
+
+#ifndef GROUP_H
+#define GROUP_H
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include "DenseArray.hpp"
+#include "PagedVector.hpp"
+
+/**
+ * @brief Entities owning every component of a Registry group, packed.
+ *
+ * The Registry keeps the first size() slots of each owned pool for the group
+ * members, in the same entity order in every pool: data<Position>(i) and
+ * data<Velocity>(i) belong to the same entity. Pools share their page size,
+ * so the members from i to the end of its page are contiguous in every pool
+ * and a kernel can stream them without any lookup (see for_each_run). Writes
+ * through data() or each() are not change-tracked: stamp them with
+ * dense_array::touch().
+ */
+template <typename... Owned>
+class component_group {
+public:
+    using Entity = std::size_t;
+
+    component_group(const std::size_t& size, dense_array<Owned>&... pools) : _size(&size), _pools(&pools...) {}
+
+    std::size_t size() const { return *_size; }
+    bool empty() const { return *_size == 0; }
+
+    static constexpr std::size_t page_size = paged_vector<int>::page_size;
+
+    // Component of the i-th member; the next members up to the page end follow it.
+    template <typename Component>
+    Component* data(std::size_t i) const {
+        return std::get<dense_array<Component>*>(_pools)->slot_data(i);
+    }
+
+    // Calls f(first, count) for the contiguous runs covering the members in [begin, end).
+    template <typename Function>
+    static void for_each_run(std::size_t begin, std::size_t end, Function&& f) {
+        while (begin < end) {
+            std::size_t pageEnd = (begin / page_size + 1) * page_size;
+            std::size_t runEnd = pageEnd < end ? pageEnd : end;
+            f(begin, runEnd - begin);
+            begin = runEnd;
+        }
+    }
+
+    // Slot index of the i-th member.
+    Entity entity(std::size_t i) const {
+        return std::get<0>(_pools)->entities()[i];
+    }
+
+    // Calls f(index, components...) or f(components...) for every member.
+    template <typename Function>
+    void each(Function&& f) const {
+        for (std::size_t i = 0; i < *_size; ++i) {
+            if constexpr (std::is_invocable_v<Function&, Entity, Owned&...>) {
+                f(entity(i), std::get<dense_array<Owned>*>(_pools)->at_slot(i)...);
+            } else {
+                f(std::get<dense_array<Owned>*>(_pools)->at_slot(i)...);
+            }
+        }
+    }
+
+private:
+    const std::size_t* _size;
+    std::tuple<dense_array<Owned>*...> _pools;
+};
+
+#endif // GROUP_H
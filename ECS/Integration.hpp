@@ -0,0 +1,78 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** Integration
+*/
+
+#ifndef INTEGRATION_H
+#define INTEGRATION_H
+
+#include <cstddef>
+
+#if defined(ECS_SIMD_AVX) && defined(__AVX__)
+    #include <immintrin.h>
+    #define ECS_SIMD_WIDTH 8
+#elif (defined(ECS_SIMD_AVX) || defined(ECS_SIMD_SSE)) && (defined(__SSE2__) || defined(_M_X64))
+    #include <emmintrin.h>
+    #define ECS_SIMD_WIDTH 4
+#else
+    #define ECS_SIMD_WIDTH 1
+#endif
+
+/**
+ * @brief Integration kernels over packed (x, y) float pairs.
+ *
+ * Position and Velocity are both two floats, so once a group packs them in
+ * the same order their pools are two flat float arrays, and moving n entities
+ * is 2n independent additions. The instruction set is picked at build time by
+ * the ECS_SIMD CMake option (AVX, SSE or SCALAR); the scalar loops also handle
+ * the remainder that does not fill a register.
+ */
+namespace integration {
+
+    // xy[i] += dxy[i] for the 2 * count floats of count entities.
+    inline void integrate(float* xy, const float* dxy, std::size_t count) {
+        std::size_t n = 2 * count;
+        std::size_t i = 0;
+#if ECS_SIMD_WIDTH == 8
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(xy + i, _mm256_add_ps(_mm256_loadu_ps(xy + i), _mm256_loadu_ps(dxy + i)));
+        }
+#elif ECS_SIMD_WIDTH == 4
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(xy + i, _mm_add_ps(_mm_loadu_ps(xy + i), _mm_loadu_ps(dxy + i)));
+        }
+#endif
+        for (; i < n; ++i) {
+            xy[i] += dxy[i];
+        }
+    }
+
+    // xy[2k, 2k + 1] += dxy[2k, 2k + 1] * scale[k] for count entities.
+    inline void integrate_scaled(float* xy, const float* dxy, const float* scale, std::size_t count) {
+        std::size_t k = 0;
+#if ECS_SIMD_WIDTH == 8
+        for (; k + 4 <= count; k += 4) {
+            __m128 s = _mm_loadu_ps(scale + k);
+            __m256 pairs = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(s, s)), _mm_unpackhi_ps(s, s), 1);
+            __m256 moved = _mm256_add_ps(_mm256_loadu_ps(xy + 2 * k), _mm256_mul_ps(_mm256_loadu_ps(dxy + 2 * k), pairs));
+            _mm256_storeu_ps(xy + 2 * k, moved);
+        }
+#elif ECS_SIMD_WIDTH == 4
+        for (; k + 4 <= count; k += 4) {
+            __m128 s = _mm_loadu_ps(scale + k);
+            __m128 lo = _mm_add_ps(_mm_loadu_ps(xy + 2 * k), _mm_mul_ps(_mm_loadu_ps(dxy + 2 * k), _mm_unpacklo_ps(s, s)));
+            __m128 hi = _mm_add_ps(_mm_loadu_ps(xy + 2 * k + 4), _mm_mul_ps(_mm_loadu_ps(dxy + 2 * k + 4), _mm_unpackhi_ps(s, s)));
+            _mm_storeu_ps(xy + 2 * k, lo);
+            _mm_storeu_ps(xy + 2 * k + 4, hi);
+        }
+#endif
+        for (; k < count; ++k) {
+            xy[2 * k] += dxy[2 * k] * scale[k];
+            xy[2 * k + 1] += dxy[2 * k + 1] * scale[k];
+        }
+    }
+}
+
+#endif // INTEGRATION_H
@@ -8,106 +8,470 @@
 #ifndef REGISTRY_H
 #define REGISTRY_H
 
-#include <unordered_map>
-#include <typeindex>
-#include <any>
+#include <typeinfo>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <vector>
+#include <memory>
+#include <string>
 #include <stdexcept>
-#include "SparseArray.hpp"
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include "ComponentTraits.hpp"
+#include "ComponentPool.hpp"
+#include "View.hpp"
+#include "Group.hpp"
+#include "CommandBuffer.hpp"
+#include "ThreadPool.hpp"
+#include "Snapshot.hpp"
+#include "Signal.hpp"
 
 
+/**
+ * @brief Owns the entities, their component pools and the systems.
+ *
+ * An Entity is a handle packing a slot index (low bits) and the generation of
+ * that slot (high bits). Killing an entity bumps the generation of its slot,
+ * so handles kept after the kill (or after the slot is reused) are detected
+ * as stale by entity_exists() in constant time.
+ * Component pools and views are addressed by slot index: use entity_index()
+ * to go from a handle to a slot and entity_from_index() for the way back.
+ *
+ * Systems declare the components they touch: add_system<Position, const Velocity>
+ * writes Position and only reads Velocity. run_systems() groups systems into
+ * stages where no two systems write a component the other one uses, runs each
+ * stage on the worker pool and flushes the command buffer between stages.
+ * A system must not touch undeclared components nor change the structure
+ * outside of commands(); systems calling commands().spawn() or doing anything
+ * else with the registry go through add_exclusive_system and run alone.
+ *
+ * group<Position, Velocity>() asks the registry to keep the entities owning
+ * all those components packed at the front of each pool, in the same order
+ * (see component_group). Groups are maintained by add/emplace/remove_component
+ * and kill_entity, not by direct pool writes. Two groups either own disjoint
+ * components or one owns a subset of the other, like Position+Velocity and
+ * Position+Velocity+Projectile.
+ *
+ * Dense pools stamp the components added or written (dense_array::patch(),
+ * replace(), touch()) with tick(), which
+ * the game moves forward once per frame with advance_tick(). A consumer keeps
+ * the tick it last synced at and queries view<Changed<Position>>(synced) or
+ * removed_since<Position>(synced) to only visit what happened since. Removals
+ * are kept for removal_history ticks.
+ *
+ * snapshot() copies the entity table and every pool of trivially copyable
+ * components into one versioned buffer, in bulk for dense pools; restore()
+ * brings the registry back to that state. Pools of other components are not
+ * saved and restore() empties them. Dynamic component ids depend on the order
+ * types are first used, so both sides must register the same components in
+ * the same order.
+ *
+ * Each slot keeps a mask of the components its entity owns, so kill_entity()
+ * only visits those pools. on_construct<T>() and on_destroy<T>() are signals
+ * fired when an entity gains or loses a T through the registry (kill
+ * included); restore() and compact() do not fire them.
+ */
 class Registry {
 public:
     using Entity = std::size_t;
 
+    static constexpr std::size_t index_bits = 32;
+    static constexpr Entity index_mask = (static_cast<Entity>(1) << index_bits) - 1;
+
+    static std::size_t entity_index(Entity const& e) { return e & index_mask; }
+    static std::size_t entity_generation(Entity const& e) { return e >> index_bits; }
+    static Entity make_entity(std::size_t index, std::size_t generation) {
+        return (static_cast<Entity>(generation) << index_bits) | (index & index_mask);
+    }
+
+    static constexpr tick_t removal_history = 256;
+    static constexpr std::uint32_t snapshot_magic = 0x53534345; // "ECSS"
+    static constexpr std::uint32_t snapshot_version = 1;
+
+    Registry() : _commands(*this) {}
+    ~Registry() = default;
+
+    // A game world is shared, never duplicated: systems capture the registry address.
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    // Reuses the lowest free slot, so slot indices stay below the peak number
+    // of live entities and pools indexed by slot stay as small.
     Entity spawn_entity() {
+        std::size_t index;
         if (!deadEntities.empty()) {
-            Entity id = deadEntities.back();
+            std::pop_heap(deadEntities.begin(), deadEntities.end(), std::greater<>());
+            index = deadEntities.back();
             deadEntities.pop_back();
-            return id;
+        } else {
+            index = _slots.size();
+            _slots.push_back({});
         }
-        return nextEntity++;
+        _slots[index].alive = true;
+        return make_entity(index, _slots[index].generation);
     }
 
-    Entity entity_from_index(std::size_t idx) {
-        return static_cast<Entity>(idx);
+    // Handle of the entity currently living in a slot.
+    Entity entity_from_index(std::size_t idx) const {
+        return idx < _slots.size() ? make_entity(idx, _slots[idx].generation) : static_cast<Entity>(idx);
     }
 
     void kill_entity(Entity const& e) {
-        for (auto& func : eraseFunctions) {
-            func(*this, e);
+        if (!entity_exists(e)) {
+            return;
+        }
+        std::size_t index = entity_index(e);
+        for_each_owned(index, [this, &e](std::size_t id) {
+            emit(_destroySignals, id, e);
+        });
+        leave_groups(index, no_component);
+        for_each_owned(index, [this, index](std::size_t id) {
+            _pools[id]->erase(index);
+        });
+        _slots[index].mask = 0;
+        _slots[index].alive = false;
+        ++_slots[index].generation;
+        deadEntities.push_back(index);
+        std::push_heap(deadEntities.begin(), deadEntities.end(), std::greater<>());
+    }
+
+    std::size_t alive_count() const { return _slots.size() - deadEntities.size(); }
+
+    // Moves the live entities of the highest slots into the free slots below
+    // alive_count() and shrinks every pool index to that size. Returns the
+    // (old, new) handle of each moved entity: old handles become stale. Meant
+    // for quiet periods, with no pending command.
+    std::vector<std::pair<Entity, Entity>> compact() {
+        std::vector<std::pair<Entity, Entity>> moves;
+        std::size_t live = alive_count();
+        std::size_t low = 0;
+        for (std::size_t high = live; high < _slots.size(); ++high) {
+            if (!_slots[high].alive) {
+                continue;
+            }
+            while (_slots[low].alive) {
+                ++low;
+            }
+            for (auto& pool : _pools) {
+                if (pool) {
+                    pool->renumber(high, low);
+                }
+            }
+            moves.emplace_back(make_entity(high, _slots[high].generation), make_entity(low, _slots[low].generation));
+            _slots[low].mask = _slots[high].mask;
+            _slots[high].mask = 0;
+            _slots[low].alive = true;
+            _slots[high].alive = false;
+            ++_slots[high].generation;
+        }
+        // Slots keep their generation so that stale handles stay detected.
+        deadEntities.clear();
+        for (std::size_t index = live; index < _slots.size(); ++index) {
+            deadEntities.push_back(index);
+        }
+        for (auto& pool : _pools) {
+            if (pool) {
+                pool->shrink_to(live);
+            }
         }
-        deadEntities.push_back(e);
+        return moves;
     }
 
     template<typename Component>
-    sparse_array<Component>& register_component() {
-        auto typeIndex = std::type_index(typeid(Component));
-        if (_componentArrays.find(typeIndex) == _componentArrays.end()) {
-            _componentArrays[typeIndex] = sparse_array<Component>();
-            eraseFunctions.push_back([](Registry& reg, Entity const& e) {
-                reg.get_components<Component>().erase(e);
-            });
+    storage_t<Component>& register_component() {
+        std::size_t id = component_id<Component>();
+        if (id >= _pools.size()) {
+            _pools.resize(id + 1);
         }
-        return std::any_cast<sparse_array<Component>&>(_componentArrays[typeIndex]);
+        if (!_pools[id]) {
+            _pools[id] = std::make_unique<pool_holder<storage_t<Component>>>();
+            _pools[id]->set_tick(_tick);
+        }
+        return static_cast<pool_holder<storage_t<Component>>&>(*_pools[id]).storage;
+    }
+
+    // Allocates room for n components of this type (and entity ids below n) up front.
+    template <typename Component>
+    void reserve(std::size_t n) {
+        register_component<Component>().reserve(n);
     }
 
     template <class Component>
-    sparse_array<Component>& get_components() {
-        auto typeIndex = std::type_index(typeid(Component));
-        auto it = _componentArrays.find(typeIndex);
-        if (it == _componentArrays.end()) {
+    storage_t<Component>& get_components() {
+        auto* pool = find_pool<Component>();
+        if (!pool) {
             throw std::out_of_range("get_components(): Component array not found for type " + std::string(typeid(Component).name()));
         }
-        try {
-            return std::any_cast<sparse_array<Component>&>(it->second);
-        } catch (const std::bad_any_cast&) {
-            throw std::runtime_error("get_components(): Type mismatch in std::any_cast for " + std::string(typeid(Component).name()));
-        }
+        return pool->storage;
     }
 
-
     template <class Component>
-    const sparse_array<Component>& get_components() const {
-        auto typeIndex = std::type_index(typeid(Component));
-        if (_componentArrays.find(typeIndex) == _componentArrays.end()) {
+    const storage_t<Component>& get_components() const {
+        const auto* pool = find_pool<Component>();
+        if (!pool) {
             throw std::out_of_range("get_components(): Component array not found");
         }
-        return std::any_cast<const sparse_array<Component>&>(_componentArrays.at(typeIndex));
+        return pool->storage;
     }
 
     template <typename Component>
-    typename sparse_array<Component>::reference_type add_component(Entity const& to, Component&& c) {
+    typename storage_t<std::decay_t<Component>>::reference_type add_component(Entity const& to, Component&& c) {
         if (!entity_exists(to)) {
             throw std::out_of_range("Entity does not exist");
         }
-        return get_components<Component>().insert_at(to, std::forward<Component>(c));
+        auto& pool = get_components<std::decay_t<Component>>();
+        bool added = !pool.contains(entity_index(to));
+        pool.insert_at(entity_index(to), std::forward<Component>(c));
+        if (added) {
+            on_added(to, component_id<std::decay_t<Component>>());
+        }
+        return pool[entity_index(to)];
     }
 
     template <typename Component, typename... Params>
-    typename sparse_array<Component>::reference_type emplace_component(Entity const& to, Params&&... p) {
+    typename storage_t<Component>::reference_type emplace_component(Entity const& to, Params&&... p) {
         if (!entity_exists(to)) {
             throw std::out_of_range("Entity does not exist");
         }
-        return get_components<Component>().emplace_at(to, std::forward<Params>(p)...);
+        auto& pool = get_components<Component>();
+        bool added = !pool.contains(entity_index(to));
+        pool.emplace_at(entity_index(to), std::forward<Params>(p)...);
+        if (added) {
+            on_added(to, component_id<Component>());
+        }
+        return pool[entity_index(to)];
+    }
+
+    template <typename Component>
+    Component& get_component(Entity const& entity) {
+        if (!has_component<Component>(entity)) {
+            throw std::out_of_range("get_component(): entity has no " + std::string(typeid(Component).name()));
+        }
+        return ecs_detail::component_at(find_pool<Component>()->storage, entity_index(entity));
     }
 
     template <typename Component>
     void remove_component(Entity const& from) {
-        get_components<Component>().erase(from);
+        auto& pool = get_components<Component>();
+        if (entity_exists(from) && pool.contains(entity_index(from))) {
+            std::size_t id = component_id<Component>();
+            emit(_destroySignals, id, from);
+            leave_groups(entity_index(from), id);
+            pool.erase(entity_index(from));
+            set_owned(entity_index(from), id, false);
+        }
+    }
+
+    // Called with the entity handle once it owns a new Component (after the
+    // value is stored), and before it loses it (kill included).
+    // Listeners must not change the structure: record changes in commands().
+    template <typename Component>
+    event_signal<Registry&, Entity>& on_construct() {
+        return signal_for(_constructSignals, component_id<Component>());
+    }
+
+    template <typename Component>
+    event_signal<Registry&, Entity>& on_destroy() {
+        return signal_for(_destroySignals, component_id<Component>());
+    }
+
+    // Pools are looked up once here; iterating the view does no further lookup.
+    // Changed/Added filters match what happened after `since`, by default
+    // during the current tick.
+    template <typename... Components>
+    component_view<Components...> view(tick_t since) {
+        return component_view<Components...>(since, get_components<ecs_detail::component_t<Components>>()...);
+    }
+
+    template <typename... Components>
+    component_view<Components...> view() {
+        return view<Components...>(_tick - 1);
+    }
+
+    tick_t tick() const { return _tick; }
+
+    // Starts the next tick: later writes are stamped with it.
+    void advance_tick() {
+        ++_tick;
+        for (auto& pool : _pools) {
+            if (pool) {
+                pool->set_tick(_tick);
+                if (_tick > removal_history) {
+                    pool->trim_removed(_tick - removal_history);
+                }
+            }
+        }
+    }
+
+    std::vector<std::byte> snapshot() const {
+        std::vector<std::byte> buffer;
+        snapshot_writer out(buffer);
+        out.write(snapshot_magic);
+        out.write(snapshot_version);
+        out.write<std::uint64_t>(_slots.size());
+        for (const slot& s : _slots) {
+            out.write(s.generation);
+            out.write<std::uint8_t>(s.alive);
+        }
+        out.write<std::uint64_t>(deadEntities.size());
+        out.write_bytes(deadEntities.data(), deadEntities.size() * sizeof(std::size_t));
+        std::uint32_t saved = 0;
+        for (const auto& pool : _pools) {
+            saved += pool && pool->snapshotable();
+        }
+        out.write(saved);
+        for (std::size_t id = 0; id < _pools.size(); ++id) {
+            if (_pools[id] && _pools[id]->snapshotable()) {
+                out.write<std::uint32_t>(id);
+                out.write<std::uint32_t>(_pools[id]->component_size());
+                _pools[id]->save(out);
+            }
+        }
+        return buffer;
+    }
+
+    // Restored components count as added and changed at the current tick, the
+    // ones they replace as removed. Pending commands must be flushed first.
+    // A corrupted entity table is rejected before anything changes; a
+    // corrupted pool leaves the registry empty.
+    void restore(std::vector<std::byte> const& buffer) {
+        snapshot_reader in(buffer.data(), buffer.size());
+        if (in.read<std::uint32_t>() != snapshot_magic || in.read<std::uint32_t>() != snapshot_version) {
+            throw std::runtime_error("restore(): not a registry snapshot of this version");
+        }
+        std::vector<slot> slots(in.read_count(sizeof(std::uint32_t) + sizeof(std::uint8_t)));
+        std::vector<bool> alive(slots.size());
+        for (std::size_t index = 0; index < slots.size(); ++index) {
+            slots[index].generation = in.read<std::uint32_t>();
+            slots[index].alive = in.read<std::uint8_t>() != 0;
+            alive[index] = slots[index].alive;
+        }
+        std::vector<std::size_t> dead(in.read_count(sizeof(std::size_t)));
+        std::memcpy(dead.data(), in.take(dead.size() * sizeof(std::size_t)), dead.size() * sizeof(std::size_t));
+        // spawn_entity() hands these slots out: each must be a dead slot, once.
+        std::vector<bool> listed(slots.size());
+        for (std::size_t index : dead) {
+            if (index >= slots.size() || slots[index].alive || listed[index]) {
+                throw std::runtime_error("restore(): free list names a live or unknown slot");
+            }
+            listed[index] = true;
+        }
+
+        for (auto& pool : _pools) {
+            if (pool) {
+                pool->clear();
+            }
+        }
+        _slots = std::move(slots);
+        deadEntities = std::move(dead);
+        std::make_heap(deadEntities.begin(), deadEntities.end(), std::greater<>());
+        try {
+            for (std::uint32_t count = in.read<std::uint32_t>(); count != 0; --count) {
+                std::size_t id = in.read<std::uint32_t>();
+                std::size_t size = in.read<std::uint32_t>();
+                if (id >= _pools.size() || !_pools[id] || !_pools[id]->snapshotable() || _pools[id]->component_size() != size) {
+                    throw std::runtime_error("restore(): component " + std::to_string(id) + " is not registered with the same type");
+                }
+                _pools[id]->load(in, alive);
+            }
+        } catch (...) {
+            clear_all();
+            throw;
+        }
+        for (std::size_t index = 0; index < _slots.size(); ++index) {
+            for (std::size_t id = 0; id < _pools.size() && id < mask_bits; ++id) {
+                if (_pools[id] && _pools[id]->contains(index)) {
+                    set_owned(index, id, true);
+                }
+            }
+        }
+        rebuild_groups();
+    }
+
+    // Slot indices of the entities that lost their Component after the tick.
+    template <typename Component>
+    std::vector<std::size_t> removed_since(tick_t since) const {
+        static_assert(std::is_same_v<storage_t<Component>, dense_array<Component>>, "change tracking needs dense_array storage");
+        return get_components<Component>().removed_since(since);
+    }
+
+    template <typename... Owned>
+    bool has_group() const {
+        std::vector<std::size_t> owned{component_id<Owned>()...};
+        std::sort(owned.begin(), owned.end());
+        return std::any_of(_groups.begin(), _groups.end(), [&owned](const auto& g) { return g->owned == owned; });
+    }
+
+    // Registers the group on first call; later calls return the same group.
+    template <typename... Owned>
+    component_group<Owned...> group() {
+        static_assert(sizeof...(Owned) > 1, "a group packs at least two components");
+        static_assert((std::is_same_v<storage_t<Owned>, dense_array<Owned>> && ...), "grouped components need dense_array storage");
+        std::vector<std::size_t> owned{component_id<Owned>()...};
+        std::sort(owned.begin(), owned.end());
+        for (auto& existing : _groups) {
+            if (existing->owned == owned) {
+                return component_group<Owned...>(existing->size, get_components<Owned>()...);
+            }
+        }
+        for (auto& existing : _groups) {
+            std::vector<std::size_t> common;
+            std::set_intersection(owned.begin(), owned.end(), existing->owned.begin(), existing->owned.end(), std::back_inserter(common));
+            if (!common.empty() && common != owned && common != existing->owned) {
+                throw std::logic_error("group(): groups must own disjoint or nested component sets");
+            }
+        }
+        (get_components<Owned>(), ...);
+        auto created = std::make_unique<group_data>();
+        created->owned = owned;
+        group_data& result = *created;
+        _groups.push_back(std::move(created));
+        std::stable_sort(_groups.begin(), _groups.end(), [](const auto& a, const auto& b) {
+            return a->owned.size() > b->owned.size();
+        });
+        rebuild_groups();
+        return component_group<Owned...>(result.size, get_components<Owned>()...);
     }
 
     template <class... Components, typename Function>
     void add_system(Function&& f) {
-        systems.emplace_back([this, f = std::forward<Function>(f)]() {
-            f(*this, get_components<Components>()...);
-        });
+        push_system<Components...>(std::forward<Function>(f), false);
+    }
+
+    template <class... Components, typename Function>
+    void add_exclusive_system(Function&& f) {
+        push_system<Components...>(std::forward<Function>(f), true);
+    }
+
+    // Structural changes made while iterating must go through here.
+    command_buffer<Registry>& commands() {
+        return _commands;
+    }
+
+    void flush_commands() {
+        _commands.flush();
+    }
+
+    // Systems run on the shared pool unless another one is given here.
+    void set_thread_pool(thread_pool& pool) {
+        _pool = &pool;
     }
 
     void run_systems() {
-        for (auto& system : systems) {
-            system();
+        if (_stagesDirty) {
+            build_stages();
+        }
+        thread_pool& pool = _pool ? *_pool : thread_pool::shared();
+        std::vector<std::function<void()>> tasks;
+        for (auto& stage : _stages) {
+            tasks.clear();
+            for (std::size_t index : stage) {
+                tasks.push_back(systems[index].run);
+            }
+            pool.run(tasks);
+            _commands.flush();
         }
     }
 
@@ -116,24 +480,230 @@ public:
         if (!entity_exists(entity)) {
             return false;
         }
-        auto typeIndex = std::type_index(typeid(Component));
-        if (_componentArrays.find(typeIndex) == _componentArrays.end()) {
-            return false;
-        }
-        const auto& array = std::any_cast<const sparse_array<Component>&>(_componentArrays.at(typeIndex));
-        return array.contains(entity);
+        const auto* pool = find_pool<Component>();
+        return pool && pool->storage.contains(entity_index(entity));
     }
 
     bool entity_exists(Entity const& entity) const {
-        return entity < nextEntity && std::find(deadEntities.begin(), deadEntities.end(), entity) == deadEntities.end();
+        std::size_t index = entity_index(entity);
+        return index < _slots.size() && _slots[index].alive && _slots[index].generation == entity_generation(entity);
     }
 
 private:
-    Entity nextEntity = 0;
-    std::vector<Entity> deadEntities;
-    std::unordered_map<std::type_index, std::any> _componentArrays;
-    std::vector<std::function<void(Registry&, Entity const&)>> eraseFunctions;
-    std::vector<std::function<void()>> systems;
+    template <typename Component>
+    pool_holder<storage_t<Component>>* find_pool() const {
+        std::size_t id = component_id<Component>();
+        if (id >= _pools.size() || !_pools[id]) {
+            return nullptr;
+        }
+        return static_cast<pool_holder<storage_t<Component>>*>(_pools[id].get());
+    }
+
+    static constexpr std::size_t no_component = static_cast<std::size_t>(-1);
+    // Component ids tracked in the per-entity mask; pools of higher ids are probed.
+    static constexpr std::size_t mask_bits = 64;
+
+    void set_owned(std::size_t index, std::size_t id, bool owned) {
+        if (id < mask_bits) {
+            std::uint64_t bit = static_cast<std::uint64_t>(1) << id;
+            _slots[index].mask = owned ? _slots[index].mask | bit : _slots[index].mask & ~bit;
+        }
+    }
+
+    // Calls f(id) for every component the entity owns, without visiting the other pools.
+    template <typename Function>
+    void for_each_owned(std::size_t index, Function&& f) {
+        std::uint64_t mask = _slots[index].mask;
+        for (std::size_t id = 0; mask != 0; ++id, mask >>= 1) {
+            if (mask & 1) {
+                f(id);
+            }
+        }
+        for (std::size_t id = mask_bits; id < _pools.size(); ++id) {
+            if (_pools[id] && _pools[id]->contains(index)) {
+                f(id);
+            }
+        }
+    }
+
+    void on_added(Entity const& entity, std::size_t id) {
+        enter_groups(entity_index(entity));
+        set_owned(entity_index(entity), id, true);
+        emit(_constructSignals, id, entity);
+    }
+
+    using component_signal = event_signal<Registry&, Entity>;
+
+    static component_signal& signal_for(std::vector<std::unique_ptr<component_signal>>& signals, std::size_t id) {
+        if (id >= signals.size()) {
+            signals.resize(id + 1);
+        }
+        if (!signals[id]) {
+            signals[id] = std::make_unique<component_signal>();
+        }
+        return *signals[id];
+    }
+
+    void emit(std::vector<std::unique_ptr<component_signal>> const& signals, std::size_t id, Entity entity) {
+        if (id < signals.size() && signals[id]) {
+            signals[id]->emit(*this, entity);
+        }
+    }
+
+    struct group_data {
+        std::vector<std::size_t> owned;
+        std::size_t size = 0;
+    };
+
+    bool in_group(const group_data& g, std::size_t index) const {
+        return _pools[g.owned.front()]->slot_of(index) < g.size;
+    }
+
+    bool owns_all(const group_data& g, std::size_t index) const {
+        return std::all_of(g.owned.begin(), g.owned.end(), [this, index](std::size_t id) {
+            return _pools[id]->contains(index);
+        });
+    }
+
+    void move_slot(const group_data& g, std::size_t index, std::size_t to) {
+        for (std::size_t id : g.owned) {
+            _pools[id]->swap_slots(_pools[id]->slot_of(index), to);
+        }
+    }
+
+    // _groups is sorted from the largest owned set down: a nested group is
+    // entered after and left before the group it is nested in.
+    void enter_groups(std::size_t index) {
+        for (auto it = _groups.rbegin(); it != _groups.rend(); ++it) {
+            group_data& g = **it;
+            if (owns_all(g, index) && !in_group(g, index)) {
+                move_slot(g, index, g.size);
+                ++g.size;
+            }
+        }
+    }
+
+    void leave_groups(std::size_t index, std::size_t removed) {
+        for (auto& g : _groups) {
+            bool affected = removed == no_component
+                || std::find(g->owned.begin(), g->owned.end(), removed) != g->owned.end();
+            if (affected && owns_all(*g, index) && in_group(*g, index)) {
+                --g->size;
+                move_slot(*g, index, g->size);
+            }
+        }
+    }
+
+    void clear_all() {
+        for (auto& pool : _pools) {
+            if (pool) {
+                pool->clear();
+            }
+        }
+        _slots.clear();
+        deadEntities.clear();
+        rebuild_groups();
+    }
+
+    void rebuild_groups() {
+        for (auto& g : _groups) {
+            g->size = 0;
+        }
+        for (auto it = _groups.rbegin(); it != _groups.rend(); ++it) {
+            group_data& g = **it;
+            std::vector<std::size_t> candidates;
+            for (std::size_t i = 0; i < _slots.size(); ++i) {
+                if (_slots[i].alive && owns_all(g, i)) {
+                    candidates.push_back(i);
+                }
+            }
+            for (std::size_t index : candidates) {
+                if (!in_group(g, index)) {
+                    move_slot(g, index, g.size);
+                    ++g.size;
+                }
+            }
+        }
+    }
+
+    struct system_entry {
+        std::function<void()> run;
+        std::vector<std::size_t> reads;
+        std::vector<std::size_t> writes;
+        bool exclusive;
+    };
+
+    template <class... Components, typename Function>
+    void push_system(Function&& f, bool exclusive) {
+        system_entry entry;
+        entry.run = [this, f = std::forward<Function>(f)]() {
+            f(*this, pool_for<Components>()...);
+        };
+        entry.exclusive = exclusive;
+        (declare_access<Components>(entry), ...);
+        systems.push_back(std::move(entry));
+        _stagesDirty = true;
+    }
+
+    template <typename Component>
+    std::conditional_t<std::is_const_v<Component>, const storage_t<std::remove_const_t<Component>>&, storage_t<std::remove_const_t<Component>>&> pool_for() {
+        return get_components<std::remove_const_t<Component>>();
+    }
+
+    template <typename Component>
+    static void declare_access(system_entry& entry) {
+        std::size_t id = component_id<std::remove_const_t<Component>>();
+        (std::is_const_v<Component> ? entry.reads : entry.writes).push_back(id);
+    }
+
+    static bool shares(std::vector<std::size_t> const& a, std::vector<std::size_t> const& b) {
+        return std::any_of(a.begin(), a.end(), [&b](std::size_t id) {
+            return std::find(b.begin(), b.end(), id) != b.end();
+        });
+    }
+
+    static bool conflicts(system_entry const& a, system_entry const& b) {
+        return a.exclusive || b.exclusive
+            || shares(a.writes, b.writes) || shares(a.writes, b.reads) || shares(a.reads, b.writes);
+    }
+
+    // A system goes one stage after the last earlier system it conflicts with,
+    // so conflicting systems keep their registration order.
+    void build_stages() {
+        std::vector<std::size_t> level(systems.size(), 0);
+        _stages.clear();
+        for (std::size_t i = 0; i < systems.size(); ++i) {
+            for (std::size_t j = 0; j < i; ++j) {
+                if (conflicts(systems[i], systems[j])) {
+                    level[i] = std::max(level[i], level[j] + 1);
+                }
+            }
+            if (level[i] >= _stages.size()) {
+                _stages.resize(level[i] + 1);
+            }
+            _stages[level[i]].push_back(i);
+        }
+        _stagesDirty = false;
+    }
+
+    struct slot {
+        std::uint64_t mask = 0;
+        std::uint32_t generation = 0;
+        bool alive = false;
+    };
+
+    std::vector<slot> _slots;
+    std::vector<std::size_t> deadEntities;
+    std::vector<std::unique_ptr<component_pool>> _pools;
+    std::vector<std::unique_ptr<group_data>> _groups;
+    std::vector<std::unique_ptr<component_signal>> _constructSignals;
+    std::vector<std::unique_ptr<component_signal>> _destroySignals;
+    std::vector<system_entry> systems;
+    std::vector<std::vector<std::size_t>> _stages;
+    bool _stagesDirty = false;
+    tick_t _tick = 1;
+    thread_pool* _pool = nullptr;
+    command_buffer<Registry> _commands;
 };
 
 #endif // REGISTRY_H
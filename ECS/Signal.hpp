@@ -0,0 +1,51 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** Signal
+*/
+
+#ifndef SIGNAL_H
+#define SIGNAL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief List of listeners called in connection order by emit().
+ *
+ * connect() returns an id to give back to disconnect(). Listeners must not
+ * connect or disconnect from the signal being emitted.
+ */
+template <typename... Args>
+class event_signal {
+public:
+    using listener = std::function<void(Args...)>;
+
+    std::size_t connect(listener f) {
+        _listeners.emplace_back(++_lastId, std::move(f));
+        return _lastId;
+    }
+
+    void disconnect(std::size_t id) {
+        _listeners.erase(std::remove_if(_listeners.begin(), _listeners.end(),
+            [id](const auto& entry) { return entry.first == id; }), _listeners.end());
+    }
+
+    bool empty() const { return _listeners.empty(); }
+
+    void emit(Args... args) const {
+        for (const auto& entry : _listeners) {
+            entry.second(args...);
+        }
+    }
+
+private:
+    std::vector<std::pair<std::size_t, listener>> _listeners;
+    std::size_t _lastId = 0;
+};
+
+#endif // SIGNAL_H
@@ -0,0 +1,151 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** Snapshot
+*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "DenseArray.hpp"
+#include "SparseArray.hpp"
+
+/**
+ * @brief Byte buffer a Registry snapshot is written to.
+ *
+ * Values are stored with their in-memory layout: a snapshot is restored by the
+ * same build on the same platform (late join of a server replica, rollback,
+ * crash recovery), it is not a wire format.
+ */
+class snapshot_writer {
+public:
+    explicit snapshot_writer(std::vector<std::byte>& out) : _out(out) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshots copy values byte for byte");
+        write_bytes(&value, sizeof(T));
+    }
+
+    void write_bytes(const void* data, std::size_t size) {
+        std::size_t at = _out.size();
+        _out.resize(at + size);
+        std::memcpy(_out.data() + at, data, size);
+    }
+
+private:
+    std::vector<std::byte>& _out;
+};
+
+// Reads back what a snapshot_writer wrote; running past the end throws.
+class snapshot_reader {
+public:
+    snapshot_reader(const std::byte* data, std::size_t size) : _pos(data), _end(data + size) {}
+
+    template <typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    // Address of the next size bytes, which the caller copies out.
+    const std::byte* take(std::size_t size) {
+        if (remaining() < size) {
+            throw std::runtime_error("snapshot: truncated buffer");
+        }
+        const std::byte* at = _pos;
+        _pos += size;
+        return at;
+    }
+
+    // Reads an element count, and checks that many elements of size bytes
+    // each are left before anyone multiplies or allocates with it.
+    std::size_t read_count(std::size_t size) {
+        std::uint64_t count = read<std::uint64_t>();
+        if (size != 0 && count > remaining() / size) {
+            throw std::runtime_error("snapshot: truncated buffer");
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    std::size_t remaining() const { return static_cast<std::size_t>(_end - _pos); }
+    bool done() const { return _pos == _end; }
+
+private:
+    const std::byte* _pos;
+    const std::byte* _end;
+};
+
+namespace ecs_detail {
+    // Dense pool: count, owning entities, then the packed components, all copied in bulk.
+    template <typename Component>
+    void save_pool(snapshot_writer& out, const dense_array<Component>& pool) {
+        out.write<std::uint64_t>(pool.size());
+        out.write_bytes(pool.entities().data(), pool.size() * sizeof(std::size_t));
+        pool.for_each_run([&out](const Component* data, std::size_t count) {
+            out.write_bytes(data, count * sizeof(Component));
+        });
+    }
+
+    // Components may only belong to live entities, one each.
+    inline void check_owner(const std::vector<bool>& alive, std::vector<bool>& owned, std::size_t entity) {
+        if (entity >= alive.size() || !alive[entity]) {
+            throw std::runtime_error("snapshot: component of an unknown entity");
+        }
+        if (owned[entity]) {
+            throw std::runtime_error("snapshot: entity owns the component twice");
+        }
+        owned[entity] = true;
+    }
+
+    template <typename Component>
+    void load_pool(snapshot_reader& in, dense_array<Component>& pool, const std::vector<bool>& alive) {
+        std::size_t count = in.read_count(sizeof(std::size_t) + sizeof(Component));
+        const std::byte* entities = in.take(count * sizeof(std::size_t));
+        const std::byte* components = in.take(count * sizeof(Component));
+        std::vector<bool> owned(alive.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t entity;
+            std::memcpy(&entity, entities + i * sizeof(std::size_t), sizeof(entity));
+            check_owner(alive, owned, entity);
+        }
+        pool.append_raw(entities, components, count);
+    }
+
+    // Sparse pool: count, then (entity, component) records for the set slots.
+    template <typename Component>
+    void save_pool(snapshot_writer& out, const sparse_array<Component>& pool) {
+        std::uint64_t count = 0;
+        for (const auto& slot : pool) {
+            count += slot.has_value();
+        }
+        out.write(count);
+        for (std::size_t i = 0; i < pool.size(); ++i) {
+            if (pool[i]) {
+                out.write<std::uint64_t>(i);
+                out.write(*pool[i]);
+            }
+        }
+    }
+
+    template <typename Component>
+    void load_pool(snapshot_reader& in, sparse_array<Component>& pool, const std::vector<bool>& alive) {
+        std::size_t count = in.read_count(sizeof(std::uint64_t) + sizeof(Component));
+        std::vector<bool> owned(alive.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t entity = in.read<std::uint64_t>();
+            check_owner(alive, owned, entity);
+            pool.insert_at(entity, in.read<Component>());
+        }
+    }
+}
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,129 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** SpatialGrid
+*/
+
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Axis-aligned box, top-left corner and size.
+ *
+ * Boxes touching by an edge do not intersect, like sf::FloatRect.
+ */
+struct aabb {
+    float left;
+    float top;
+    float width;
+    float height;
+
+    float right() const { return left + width; }
+    float bottom() const { return top + height; }
+
+    bool intersects(const aabb& other) const {
+        return std::max(left, other.left) < std::min(right(), other.right())
+            && std::max(top, other.top) < std::min(bottom(), other.bottom());
+    }
+};
+
+/**
+ * @brief Uniform grid broad-phase, rebuilt every tick.
+ *
+ * insert() files a box under every cell it covers, for_each_pair() tests only
+ * the boxes sharing a cell. A pair sharing several cells is reported once, by
+ * the cell holding the top-left corner of the intersection of the two boxes.
+ * Pick a cell size around the size of the common boxes: bullets and ships.
+ */
+class spatial_grid {
+public:
+    explicit spatial_grid(float cellSize = 64.0f) : _cellSize(cellSize) {}
+
+    void clear() {
+        _boxes.clear();
+        _cells.clear();
+        _sorted = true;
+    }
+
+    // Stores a box under the id the pairs will be reported with.
+    void insert(std::size_t id, const aabb& box) {
+        _boxes.push_back({id, box});
+        std::size_t ref = _boxes.size() - 1;
+        std::int32_t x0 = cell_of(box.left);
+        std::int32_t x1 = cell_of(box.right());
+        std::int32_t y0 = cell_of(box.top);
+        std::int32_t y1 = cell_of(box.bottom());
+        for (std::int32_t y = y0; y <= y1; ++y) {
+            for (std::int32_t x = x0; x <= x1; ++x) {
+                _cells.push_back({key(x, y), ref});
+            }
+        }
+        _sorted = false;
+    }
+
+    // Calls f(idA, idB), idA < idB, once for every pair of intersecting boxes.
+    template <typename Function>
+    void for_each_pair(Function&& f) {
+        if (!_sorted) {
+            std::sort(_cells.begin(), _cells.end(), [](const cell_entry& a, const cell_entry& b) {
+                return a.cell != b.cell ? a.cell < b.cell : a.ref < b.ref;
+            });
+            _sorted = true;
+        }
+        for (std::size_t begin = 0; begin < _cells.size();) {
+            std::size_t end = begin + 1;
+            while (end < _cells.size() && _cells[end].cell == _cells[begin].cell) {
+                ++end;
+            }
+            for (std::size_t a = begin; a < end; ++a) {
+                const stored_box& first = _boxes[_cells[a].ref];
+                for (std::size_t b = a + 1; b < end; ++b) {
+                    const stored_box& second = _boxes[_cells[b].ref];
+                    if (!first.box.intersects(second.box)) {
+                        continue;
+                    }
+                    float left = std::max(first.box.left, second.box.left);
+                    float top = std::max(first.box.top, second.box.top);
+                    if (key(cell_of(left), cell_of(top)) != _cells[begin].cell) {
+                        continue;
+                    }
+                    f(std::min(first.id, second.id), std::max(first.id, second.id));
+                }
+            }
+            begin = end;
+        }
+    }
+
+private:
+    struct stored_box {
+        std::size_t id;
+        aabb box;
+    };
+
+    struct cell_entry {
+        std::uint64_t cell;
+        std::size_t ref;
+    };
+
+    std::int32_t cell_of(float coordinate) const {
+        return static_cast<std::int32_t>(std::floor(coordinate / _cellSize));
+    }
+
+    static std::uint64_t key(std::int32_t x, std::int32_t y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) << 32) | static_cast<std::uint32_t>(x);
+    }
+
+    float _cellSize;
+    std::vector<stored_box> _boxes;
+    std::vector<cell_entry> _cells;
+    bool _sorted = true;
+};
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,229 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** ThreadPool
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads running batches of tasks.
+ *
+ * Every worker owns a task deque: it pops its own tasks from the back and,
+ * once it runs dry, steals from the front of the others, so uneven batches
+ * (a chunk full of colliding bullets next to an empty one) still keep every
+ * core busy. Tasks submitted from a worker go to its own deque.
+ *
+ * run() blocks until every task of the batch is done, and the calling thread
+ * executes queued tasks while it waits: a task may itself call run() without
+ * starving the pool. The first exception thrown by a task is rethrown by run().
+ */
+class thread_pool {
+public:
+    explicit thread_pool(std::size_t workers = default_workers()) {
+        for (std::size_t i = 0; i < workers; ++i) {
+            _queues.push_back(std::make_unique<task_queue>());
+        }
+        for (std::size_t i = 0; i < workers; ++i) {
+            _workers.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cond.notify_all();
+        for (auto& worker : _workers) {
+            worker.join();
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    std::size_t size() const { return _workers.size(); }
+
+    void run(std::vector<std::function<void()>>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+        if (tasks.size() == 1 || _workers.empty()) {
+            for (auto& task : tasks) {
+                task();
+            }
+            return;
+        }
+        auto batch = std::make_shared<batch_state>();
+        batch->remaining = tasks.size();
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            push(i, [batch, &task = tasks[i]] {
+                try {
+                    task();
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(batch->mutex);
+                    if (!batch->error) {
+                        batch->error = std::current_exception();
+                    }
+                }
+                if (batch->remaining.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> guard(batch->mutex);
+                    batch->cond.notify_all();
+                }
+            });
+        }
+        {
+            // Orders the pushes with workers checking for work before they sleep.
+            std::lock_guard<std::mutex> lock(_mutex);
+        }
+        _cond.notify_all();
+        while (batch->remaining.load() != 0) {
+            if (!run_one(current_worker())) {
+                std::unique_lock<std::mutex> lock(batch->mutex);
+                batch->cond.wait(lock, [&batch] { return batch->remaining.load() == 0; });
+            }
+        }
+        if (batch->error) {
+            std::rethrow_exception(batch->error);
+        }
+    }
+
+    // Calls f(begin, end) on consecutive ranges of at most grain items covering [0, count).
+    template <typename Function>
+    void parallel_for(std::size_t count, std::size_t grain, Function&& f) {
+        if (count <= grain) {
+            if (count != 0) {
+                f(std::size_t(0), count);
+            }
+            return;
+        }
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve((count + grain - 1) / grain);
+        for (std::size_t begin = 0; begin < count; begin += grain) {
+            std::size_t end = begin + grain < count ? begin + grain : count;
+            tasks.emplace_back([&f, begin, end] { f(begin, end); });
+        }
+        run(tasks);
+    }
+
+    // Pool shared by the registries of the process, one worker per spare core.
+    static thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    static std::size_t default_workers() {
+        unsigned int cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 0;
+    }
+
+private:
+    using task = std::function<void()>;
+
+    struct task_queue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    struct batch_state {
+        std::atomic<std::size_t> remaining{0};
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::exception_ptr error;
+    };
+
+    static constexpr std::size_t no_worker = static_cast<std::size_t>(-1);
+
+    struct worker_identity {
+        const thread_pool* pool = nullptr;
+        std::size_t index = no_worker;
+    };
+
+    static worker_identity& identity() {
+        static thread_local worker_identity self;
+        return self;
+    }
+
+    std::size_t current_worker() const {
+        return identity().pool == this ? identity().index : no_worker;
+    }
+
+    // A worker keeps what it submits; other threads spread a batch over the workers.
+    void push(std::size_t rank, task job) {
+        std::size_t self = current_worker();
+        std::size_t target = self != no_worker ? self : rank % _queues.size();
+        _pending.fetch_add(1);
+        std::lock_guard<std::mutex> lock(_queues[target]->mutex);
+        _queues[target]->tasks.push_back(std::move(job));
+    }
+
+    bool pop(std::size_t self, task& job) {
+        if (self != no_worker) {
+            task_queue& own = *_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                job = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        std::size_t start = self != no_worker ? self + 1 : 0;
+        for (std::size_t i = 0; i < _queues.size(); ++i) {
+            task_queue& victim = *_queues[(start + i) % _queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                job = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool run_one(std::size_t self) {
+        task job;
+        if (!pop(self, job)) {
+            return false;
+        }
+        _pending.fetch_sub(1);
+        job();
+        return true;
+    }
+
+    void worker_loop(std::size_t index) {
+        identity() = {this, index};
+        while (true) {
+            if (run_one(index)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this] { return _stop || _pending.load() != 0; });
+            if (_stop && _pending.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<task_queue>> _queues;
+    std::vector<std::thread> _workers;
+    std::atomic<std::size_t> _pending{0};
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    bool _stop = false;
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,279 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** View
+*/
+
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <tuple>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include "ComponentTraits.hpp"
+#include "ThreadPool.hpp"
+
+// View filters: the entity's Component must have been changed (or added)
+// after the view tick. The component is handed out read-only.
+template <typename Component>
+struct Changed {};
+
+template <typename Component>
+struct Added {};
+
+namespace ecs_detail {
+    enum class view_filter { none, changed, added };
+
+    template <typename Arg>
+    struct view_arg {
+        using type = Arg;
+        static constexpr view_filter filter = view_filter::none;
+    };
+
+    template <typename Component>
+    struct view_arg<Changed<Component>> {
+        static_assert(std::is_same_v<storage_t<Component>, dense_array<Component>>, "change tracking needs dense_array storage");
+        using type = const Component;
+        static constexpr view_filter filter = view_filter::changed;
+    };
+
+    template <typename Component>
+    struct view_arg<Added<Component>> {
+        static_assert(std::is_same_v<storage_t<Component>, dense_array<Component>>, "change tracking needs dense_array storage");
+        using type = const Component;
+        static constexpr view_filter filter = view_filter::added;
+    };
+
+    // What a view function receives for a view argument, and its component type.
+    template <typename Arg>
+    using yield_t = typename view_arg<Arg>::type;
+
+    template <typename Arg>
+    using component_t = std::remove_const_t<yield_t<Arg>>;
+
+    template <typename Arg>
+    using pool_t = std::conditional_t<std::is_const_v<yield_t<Arg>>,
+        const storage_t<component_t<Arg>>,
+        storage_t<component_t<Arg>>>;
+
+    template <typename Component>
+    std::size_t slot_count(const dense_array<Component>& pool) { return pool.entities().size(); }
+
+    template <typename Component>
+    std::size_t slot_count(const sparse_array<Component>& pool) { return pool.size(); }
+
+    // Calls f(entity, slot) for the entities stored at positions [begin, end) of the pool.
+    template <typename Component, typename Function>
+    void for_each_slot(const dense_array<Component>& pool, std::size_t begin, std::size_t end, Function&& f) {
+        const auto& entities = pool.entities();
+        for (std::size_t i = begin; i < end; ++i) {
+            f(entities[i], i);
+        }
+    }
+
+    template <typename Component, typename Function>
+    void for_each_slot(const sparse_array<Component>& pool, std::size_t begin, std::size_t end, Function&& f) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (pool[i]) {
+                f(i, i);
+            }
+        }
+    }
+
+    constexpr std::size_t cache_line_size = 64;
+    constexpr std::size_t min_chunk_lines = 16;
+    constexpr std::size_t chunks_per_thread = 4;
+
+    // Whole cache lines of the driving pool, small enough for every thread to
+    // get a few chunks to balance with, large enough to amortize the task.
+    template <typename Pool>
+    std::size_t chunk_size(std::size_t count, std::size_t threads) {
+        constexpr std::size_t slotBytes = sizeof(typename Pool::value_type);
+        constexpr std::size_t perLine = slotBytes >= cache_line_size ? 1 : cache_line_size / slotBytes;
+        std::size_t chunk = count / (threads * chunks_per_thread) + 1;
+        chunk = (chunk + perLine - 1) / perLine * perLine;
+        return std::max(chunk, perLine * min_chunk_lines);
+    }
+
+    template <typename Component>
+    Component& component_at(dense_array<Component>& pool, std::size_t entity) { return pool[entity]; }
+
+    template <typename Component>
+    const Component& component_at(const dense_array<Component>& pool, std::size_t entity) { return pool[entity]; }
+
+    template <typename Component>
+    Component& component_at(sparse_array<Component>& pool, std::size_t entity) { return *pool[entity]; }
+
+    template <typename Component>
+    const Component& component_at(const sparse_array<Component>& pool, std::size_t entity) { return *pool[entity]; }
+
+    // Component at a storage position, skipping the entity lookup.
+    template <typename Component>
+    Component& component_in_slot(dense_array<Component>& pool, std::size_t slot) { return pool.at_slot(slot); }
+
+    template <typename Component>
+    const Component& component_in_slot(const dense_array<Component>& pool, std::size_t slot) { return *pool.slot_data(slot); }
+
+    template <typename Component>
+    Component& component_in_slot(sparse_array<Component>& pool, std::size_t slot) { return *pool[slot]; }
+
+    template <typename Component>
+    const Component& component_in_slot(const sparse_array<Component>& pool, std::size_t slot) { return *pool[slot]; }
+}
+
+/**
+ * @brief Iterates the entities owning every listed component.
+ *
+ * The pools are resolved once, when the view is built. Iteration walks the
+ * smallest pool and only probes the others, so its cost follows the number of
+ * candidates rather than the highest entity id. A const component is handed
+ * out as a const reference.
+ * Entities are yielded as slot indices, like the pools address them; see
+ * Registry::entity_from_index() to get their handle back.
+ * Changed<T> and Added<T> only match entities whose T was changed or added
+ * after the tick given at construction.
+ * Structural changes (spawn, kill, add, remove) must not happen while iterating.
+ *
+ * parallel_each() splits the driving pool into chunks of whole cache lines and
+ * runs them on a thread pool. Every entity is visited exactly once, so a
+ * function that only touches the components it is given gives the same result
+ * as each(), whatever the number of threads.
+ */
+template <typename... Components>
+class component_view {
+    static_assert(sizeof...(Components) > 0, "component_view needs at least one component");
+
+public:
+    using Entity = std::size_t;
+
+    explicit component_view(ecs_detail::pool_t<Components>&... pools) : _pools(&pools...) {}
+    component_view(tick_t since, ecs_detail::pool_t<Components>&... pools) : _pools(&pools...), _since(since) {}
+
+    // Calls f(index, components...) or f(components...) for every matching entity.
+    template <typename Function>
+    void each(Function&& f) const {
+        each_from_smallest(f, std::index_sequence_for<Components...>{});
+    }
+
+    // Same as each(), spread over the pool threads; f is called concurrently.
+    template <typename Function>
+    void parallel_each(Function&& f, thread_pool& pool = thread_pool::shared()) const {
+        parallel_from_smallest(f, pool, std::index_sequence_for<Components...>{});
+    }
+
+    bool contains(Entity entity) const {
+        return others_match<sizeof...(Components)>(entity, std::index_sequence_for<Components...>{});
+    }
+
+    template <typename Component>
+    Component& get(Entity entity) const {
+        return ecs_detail::component_at(*std::get<ecs_detail::pool_t<Component>*>(_pools), entity);
+    }
+
+    // Upper bound of the number of entities the view yields.
+    std::size_t size_hint() const {
+        return std::apply([](auto*... pools) {
+            std::size_t smallest = static_cast<std::size_t>(-1);
+            ((smallest = pools->size() < smallest ? pools->size() : smallest), ...);
+            return smallest;
+        }, _pools);
+    }
+
+private:
+    template <std::size_t... Is>
+    std::size_t smallest_pool(std::index_sequence<Is...>) const {
+        std::size_t smallest = 0;
+        std::size_t smallestSize = static_cast<std::size_t>(-1);
+        ((std::get<Is>(_pools)->size() < smallestSize
+            ? (smallest = Is, smallestSize = std::get<Is>(_pools)->size())
+            : 0), ...);
+        return smallest;
+    }
+
+    template <typename Function, std::size_t... Is>
+    void each_from_smallest(Function& f, std::index_sequence<Is...> seq) const {
+        std::size_t smallest = smallest_pool(seq);
+        ((smallest == Is ? each_from<Is>(f, 0, ecs_detail::slot_count(*std::get<Is>(_pools))) : void()), ...);
+    }
+
+    template <typename Function, std::size_t... Is>
+    void parallel_from_smallest(Function& f, thread_pool& pool, std::index_sequence<Is...> seq) const {
+        std::size_t smallest = smallest_pool(seq);
+        ((smallest == Is ? parallel_from<Is>(f, pool) : void()), ...);
+    }
+
+    // The driving pool is read by position: only the other pools are looked up.
+    template <std::size_t Driver, typename Function>
+    void each_from(Function& f, std::size_t begin, std::size_t end) const {
+        ecs_detail::for_each_slot(*std::get<Driver>(_pools), begin, end, [this, &f](Entity entity, std::size_t slot) {
+            if (slot_matches<Driver>(slot) && others_match<Driver>(entity, std::index_sequence_for<Components...>{})) {
+                invoke<Driver>(f, entity, slot, std::index_sequence_for<Components...>{});
+            }
+        });
+    }
+
+    template <std::size_t I>
+    bool slot_matches(std::size_t slot) const {
+        constexpr ecs_detail::view_filter filter = ecs_detail::view_arg<std::tuple_element_t<I, std::tuple<Components...>>>::filter;
+        if constexpr (filter == ecs_detail::view_filter::changed) {
+            return std::get<I>(_pools)->changed_since(slot, _since);
+        } else if constexpr (filter == ecs_detail::view_filter::added) {
+            return std::get<I>(_pools)->added_since(slot, _since);
+        } else {
+            return true;
+        }
+    }
+
+    template <std::size_t I>
+    bool matches(Entity entity) const {
+        constexpr ecs_detail::view_filter filter = ecs_detail::view_arg<std::tuple_element_t<I, std::tuple<Components...>>>::filter;
+        if constexpr (filter == ecs_detail::view_filter::none) {
+            return std::get<I>(_pools)->contains(entity);
+        } else {
+            return std::get<I>(_pools)->contains(entity) && slot_matches<I>(std::get<I>(_pools)->get_index(entity));
+        }
+    }
+
+    template <std::size_t Driver, std::size_t... Is>
+    bool others_match(Entity entity, std::index_sequence<Is...>) const {
+        return ((Is == Driver || matches<Is>(entity)) && ...);
+    }
+
+    template <std::size_t Driver, typename Function>
+    void parallel_from(Function& f, thread_pool& pool) const {
+        using driver_pool = std::remove_const_t<std::remove_pointer_t<std::tuple_element_t<Driver, decltype(_pools)>>>;
+        std::size_t count = ecs_detail::slot_count(*std::get<Driver>(_pools));
+        std::size_t chunk = ecs_detail::chunk_size<driver_pool>(count, pool.size() + 1);
+        pool.parallel_for(count, chunk, [this, &f](std::size_t begin, std::size_t end) {
+            each_from<Driver>(f, begin, end);
+        });
+    }
+
+    template <std::size_t I, std::size_t Driver>
+    decltype(auto) fetch(Entity entity, std::size_t slot) const {
+        if constexpr (I == Driver) {
+            return ecs_detail::component_in_slot(*std::get<I>(_pools), slot);
+        } else {
+            return ecs_detail::component_at(*std::get<I>(_pools), entity);
+        }
+    }
+
+    template <std::size_t Driver, typename Function, std::size_t... Is>
+    void invoke(Function& f, Entity entity, std::size_t slot, std::index_sequence<Is...>) const {
+        if constexpr (std::is_invocable_v<Function&, Entity, ecs_detail::yield_t<Components>&...>) {
+            f(entity, fetch<Is, Driver>(entity, slot)...);
+        } else {
+            f(fetch<Is, Driver>(entity, slot)...);
+        }
+    }
+
+    std::tuple<ecs_detail::pool_t<Components>*...> _pools;
+    tick_t _since = 0;
+};
+
+#endif // VIEW_H
@@ -0,0 +1,38 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** Collider
+*/
+
+#ifndef COLLIDER_H
+    #define COLLIDER_H
+
+#include <cstdint>
+#include "Position.hpp"
+#include "SpatialGrid.hpp"
+
+namespace collision_layer {
+    constexpr std::uint32_t none = 0;
+    constexpr std::uint32_t all = 0xFFFFFFFF;
+}
+
+// Box of 2 * half_width by 2 * half_height centred on the entity Position, so two
+// boxes touch when |dx| < sum of half widths and |dy| < sum of half heights.
+// Two colliders touch only if each one's layer is in the other's mask.
+struct Collider {
+    float half_width;
+    float half_height;
+    std::uint32_t layer = collision_layer::all;
+    std::uint32_t mask = collision_layer::all;
+};
+
+inline aabb collision_box(const Position& pos, const Collider& collider) {
+    return {pos.x - collider.half_width, pos.y - collider.half_height, 2.0f * collider.half_width, 2.0f * collider.half_height};
+}
+
+inline bool layers_match(const Collider& a, const Collider& b) {
+    return (a.layer & b.mask) != 0 && (b.layer & a.mask) != 0;
+}
+
+#endif // COLLIDER_H
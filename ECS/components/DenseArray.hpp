@@ -0,0 +1,303 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** DenseArray
+*/
+
+#ifndef DENSEARRAY_H
+#define DENSEARRAY_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "PagedVector.hpp"
+
+// Registry tick a component was last added or changed at.
+using tick_t = std::uint32_t;
+
+/**
+ * @brief Sparse-set component storage.
+ *
+ * Components are packed in a dense vector, with a parallel vector holding the
+ * owning entity of each slot and a sparse index mapping an entity to its slot.
+ * Iterating the storage only touches live components, and erasing moves the
+ * last component into the freed slot.
+ * Components live in arena pages that never move, so a reference stays valid
+ * until that component or another one is erased. Only the index vectors are
+ * reallocated as they grow.
+ *
+ * Each slot also records the tick its component was added at and the tick it
+ * was last changed at; the Registry sets the current tick with set_tick().
+ * Only explicit writes stamp a component as changed: patch(), replace(), and
+ * insert_at()/emplace_at() over an existing component. Plain mutable access
+ * (operator[], at_slot, mutable view arguments) does not, since most of it
+ * only reads; code writing through it, or kernels writing through
+ * slot_data(), stamp what they actually changed with touch().
+ * Erased entities are logged with their tick until trim_removed() drops them.
+ */
+template <typename Component>
+class dense_array {
+public:
+    using value_type = Component;
+    using reference_type = value_type&;
+    using const_reference_type = const value_type&;
+    using container_t = paged_vector<value_type>;
+    using size_type = typename container_t::size_type;
+    using iterator = typename container_t::iterator;
+    using const_iterator = typename container_t::const_iterator;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    static constexpr size_type page_size = container_t::page_size;
+
+    dense_array() = default;
+    dense_array(const dense_array& other) = default;
+    dense_array(dense_array&& other) noexcept = default;
+    ~dense_array() = default;
+
+    dense_array& operator=(const dense_array& other) = default;
+    dense_array& operator=(dense_array&& other) noexcept = default;
+
+    // The entity must own a component, check with contains() first.
+    reference_type operator[](size_type entity) {
+        return at_slot(_sparse[entity]);
+    }
+
+    const_reference_type operator[](size_type entity) const {
+        return _dense[_sparse[entity]];
+    }
+
+    iterator begin() { return _dense.begin(); }
+    const_iterator begin() const { return _dense.begin(); }
+    const_iterator cbegin() const { return _dense.cbegin(); }
+    iterator end() { return _dense.end(); }
+    const_iterator end() const { return _dense.end(); }
+    const_iterator cend() const { return _dense.cend(); }
+
+    size_type size() const { return _dense.size(); }
+    bool empty() const { return _dense.empty(); }
+
+    const std::vector<size_type>& entities() const { return _entities; }
+
+    reference_type at_slot(size_type slot) { return _dense[slot]; }
+
+    const_reference_type at_slot(size_type slot) const { return _dense[slot]; }
+
+    // Packed component at a slot, in the order of entities(); the slots up to
+    // the end of its page follow it contiguously. Writes through the pointer
+    // are not tracked: stamp them with touch().
+    value_type* slot_data(size_type slot) { return _dense.at_page(slot); }
+    const value_type* slot_data(size_type slot) const { return _dense.at_page(slot); }
+
+    void set_tick(tick_t tick) { _tick = tick; }
+    tick_t tick() const { return _tick; }
+
+    // Marks the components of slots [first, first + count) as changed now.
+    void touch(size_type first, size_type count = 1) {
+        std::fill_n(_changed.begin() + first, count, _tick);
+    }
+
+    // Calls f(component) on the component of the entity, and stamps it as changed.
+    template <typename Function>
+    reference_type patch(size_type entity, Function&& f) {
+        size_type slot = _sparse[entity];
+        f(_dense[slot]);
+        _changed[slot] = _tick;
+        return _dense[slot];
+    }
+
+    // Overwrites the component of the entity, and stamps it as changed.
+    reference_type replace(size_type entity, const Component& component) {
+        return patch(entity, [&component](Component& current) { current = component; });
+    }
+
+    reference_type replace(size_type entity, Component&& component) {
+        return patch(entity, [&component](Component& current) { current = std::move(component); });
+    }
+
+    bool changed_since(size_type slot, tick_t tick) const { return _changed[slot] > tick; }
+    bool added_since(size_type slot, tick_t tick) const { return _added[slot] > tick; }
+
+    // Entities whose component was erased after the tick, oldest first.
+    std::vector<size_type> removed_since(tick_t tick) const {
+        std::vector<size_type> removed;
+        for (const auto& [entity, at] : _removed) {
+            if (at > tick) {
+                removed.push_back(entity);
+            }
+        }
+        return removed;
+    }
+
+    // Forgets the removals logged at or before the tick.
+    void trim_removed(tick_t tick) {
+        auto kept = std::find_if(_removed.begin(), _removed.end(), [tick](const auto& entry) { return entry.second > tick; });
+        _removed.erase(_removed.begin(), kept);
+    }
+
+    // Allocates room for n components and for entity ids below n.
+    void reserve(size_type n) {
+        _dense.reserve(n);
+        _entities.reserve(n);
+        _added.reserve(n);
+        _changed.reserve(n);
+        if (_sparse.size() < n) {
+            _sparse.resize(n, npos);
+        }
+    }
+
+    reference_type insert_at(size_type pos, const Component& component) {
+        if (contains(pos)) {
+            return replace(pos, component);
+        }
+        link(pos);
+        _dense.push_back(component);
+        return _dense.back();
+    }
+
+    reference_type insert_at(size_type pos, Component&& component) {
+        if (contains(pos)) {
+            return replace(pos, std::move(component));
+        }
+        link(pos);
+        _dense.push_back(std::move(component));
+        return _dense.back();
+    }
+
+    template <class... Params>
+    reference_type emplace_at(size_type pos, Params&&... params) {
+        if (contains(pos)) {
+            return replace(pos, Component(std::forward<Params>(params)...));
+        }
+        link(pos);
+        _dense.emplace_back(std::forward<Params>(params)...);
+        return _dense.back();
+    }
+
+    void erase(size_type pos) {
+        if (!contains(pos)) {
+            return;
+        }
+        size_type idx = _sparse[pos];
+        size_type last = _dense.size() - 1;
+        if (idx != last) {
+            _dense[idx] = std::move(_dense[last]);
+            _entities[idx] = _entities[last];
+            _added[idx] = _added[last];
+            _changed[idx] = _changed[last];
+            _sparse[_entities[idx]] = idx;
+        }
+        _dense.pop_back();
+        _entities.pop_back();
+        _added.pop_back();
+        _changed.pop_back();
+        _sparse[pos] = npos;
+        _removed.emplace_back(pos, _tick);
+    }
+
+    size_type get_index(size_type entity) const {
+        return entity < _sparse.size() ? _sparse[entity] : npos;
+    }
+
+    bool contains(size_type entity) const {
+        return entity < _sparse.size() && _sparse[entity] != npos;
+    }
+
+    // Erases every component, logging them as removed.
+    void clear() {
+        for (size_type entity : _entities) {
+            _sparse[entity] = npos;
+            _removed.emplace_back(entity, _tick);
+        }
+        _dense.clear();
+        _entities.clear();
+        _added.clear();
+        _changed.clear();
+    }
+
+    // Gives the component of entity from to entity to, which owns none; the
+    // packed slot does not move. Logged as a removal and an addition.
+    void renumber(size_type from, size_type to) {
+        if (!contains(from)) {
+            return;
+        }
+        size_type slot = _sparse[from];
+        if (to >= _sparse.size()) {
+            _sparse.resize(to + 1, npos);
+        }
+        _sparse[to] = slot;
+        _sparse[from] = npos;
+        _entities[slot] = to;
+        _added[slot] = _tick;
+        _changed[slot] = _tick;
+        _removed.emplace_back(from, _tick);
+    }
+
+    // Releases the index room of entity ids from n up, which own no component.
+    void shrink_to(size_type n) {
+        if (_sparse.size() > n) {
+            _sparse.resize(n);
+            _sparse.shrink_to_fit();
+        }
+    }
+
+    // Calls f(data, count) for the contiguous runs of packed components.
+    template <typename Function>
+    void for_each_run(Function&& f) const { _dense.for_each_run(f); }
+
+    // Appends n components copied from raw memory, for entities not owning one
+    // yet: entities holds n size_type, components n packed components.
+    void append_raw(const void* entities, const void* components, size_type n) {
+        static_assert(std::is_trivially_copyable_v<Component>, "append_raw() copies the component bytes");
+        size_type first = _entities.size();
+        _entities.resize(first + n);
+        std::memcpy(_entities.data() + first, entities, n * sizeof(size_type));
+        _dense.append_raw(components, n);
+        _added.resize(first + n, _tick);
+        _changed.resize(first + n, _tick);
+        for (size_type i = first; i < first + n; ++i) {
+            if (_entities[i] >= _sparse.size()) {
+                _sparse.resize(_entities[i] + 1, npos);
+            }
+            _sparse[_entities[i]] = i;
+        }
+    }
+
+    // Exchanges two packed slots, keeping the entity index consistent.
+    void swap_slots(size_type a, size_type b) {
+        if (a == b) {
+            return;
+        }
+        std::swap(_dense[a], _dense[b]);
+        std::swap(_entities[a], _entities[b]);
+        std::swap(_added[a], _added[b]);
+        std::swap(_changed[a], _changed[b]);
+        _sparse[_entities[a]] = a;
+        _sparse[_entities[b]] = b;
+    }
+
+private:
+    void link(size_type pos) {
+        if (pos >= _sparse.size()) {
+            _sparse.resize(pos + 1, npos);
+        }
+        _sparse[pos] = _dense.size();
+        _entities.push_back(pos);
+        _added.push_back(_tick);
+        _changed.push_back(_tick);
+    }
+
+    container_t _dense;
+    std::vector<size_type> _entities;
+    std::vector<size_type> _sparse;
+    std::vector<tick_t> _added;
+    std::vector<tick_t> _changed;
+    std::vector<std::pair<size_type, tick_t>> _removed;
+    tick_t _tick = 0;
+};
+
+#endif // DENSEARRAY_H
@@ -0,0 +1,145 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** PageArena
+*/
+
+#ifndef PAGEARENA_H
+#define PAGEARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Allocator for the pages of component storages.
+ *
+ * Pages are carved out of large cache-line aligned blocks and a released page
+ * goes to a free list for its size, so pools growing and shrinking every wave
+ * reuse the same memory instead of going back to the heap. Once every page of
+ * a block is released the block goes back to the heap, or is rewound when it
+ * is the one pages are carved from, so the arena holds no more blocks than its
+ * live pages span. Pages larger than a block get a block of their own.
+ * Thread-safe: registries of different matches share the process arena.
+ */
+class page_arena {
+public:
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t block_size = 1 << 20;
+
+    page_arena() = default;
+
+    ~page_arena() {
+        for (auto& [base, block] : _blocks) {
+            ::operator delete(base, std::align_val_t(alignment));
+        }
+    }
+
+    page_arena(const page_arena&) = delete;
+    page_arena& operator=(const page_arena&) = delete;
+
+    void* allocate(std::size_t bytes) {
+        bytes = round_up(bytes);
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& freeList = _free[bytes];
+        if (!freeList.empty()) {
+            void* page = freeList.back();
+            freeList.pop_back();
+            ++block_of(page).live;
+            return page;
+        }
+        if (bytes > block_size) {
+            std::byte* page = new_block(bytes);
+            _blocks[page].live = 1;
+            return page;
+        }
+        if (_cursor == nullptr || _remaining < bytes) {
+            _current = new_block(block_size);
+            _cursor = _current;
+            _remaining = block_size;
+        }
+        void* page = _cursor;
+        _cursor += bytes;
+        _remaining -= bytes;
+        ++_blocks[_current].live;
+        return page;
+    }
+
+    void deallocate(void* page, std::size_t bytes) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = std::prev(_blocks.upper_bound(static_cast<std::byte*>(page)));
+        if (--it->second.live != 0) {
+            _free[round_up(bytes)].push_back(page);
+            return;
+        }
+        std::byte* base = it->first;
+        drop_free_pages(base, it->second.size);
+        if (base == _current) {
+            _cursor = _current;
+            _remaining = block_size;
+            return;
+        }
+        ::operator delete(base, std::align_val_t(alignment));
+        _blocks.erase(it);
+    }
+
+    // Blocks currently taken from the heap.
+    std::size_t block_count() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _blocks.size();
+    }
+
+    // Never destroyed, so pools living in static objects can release pages at exit.
+    static page_arena& shared() {
+        static page_arena* arena = new page_arena();
+        return *arena;
+    }
+
+private:
+    struct block {
+        std::size_t size = 0;
+        std::size_t live = 0;
+    };
+
+    static std::size_t round_up(std::size_t bytes) {
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    std::byte* new_block(std::size_t size) {
+        std::byte* base = static_cast<std::byte*>(::operator new(size, std::align_val_t(alignment)));
+        _blocks[base].size = size;
+        return base;
+    }
+
+    block& block_of(void* page) {
+        return std::prev(_blocks.upper_bound(static_cast<std::byte*>(page)))->second;
+    }
+
+    // Forgets the free pages inside [base, base + size).
+    void drop_free_pages(std::byte* base, std::size_t size) {
+        std::less<const std::byte*> before;
+        for (auto& [bytes, pages] : _free) {
+            pages.erase(std::remove_if(pages.begin(), pages.end(), [&](void* page) {
+                const std::byte* p = static_cast<const std::byte*>(page);
+                return !before(p, base) && before(p, base + size);
+            }), pages.end());
+        }
+    }
+
+    mutable std::mutex _mutex;
+    std::unordered_map<std::size_t, std::vector<void*>> _free;
+    // Keyed by base address, so the block of a page is the last one starting at or before it.
+    std::map<std::byte*, block> _blocks;
+    std::byte* _current = nullptr;
+    std::byte* _cursor = nullptr;
+    std::size_t _remaining = 0;
+};
+
+#endif // PAGEARENA_H
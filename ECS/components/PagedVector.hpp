@@ -0,0 +1,233 @@
+/*
+** EPITECH PROJECT, 2024
+** R-Type ECS
+** File description:
+** PagedVector
+*/
+
+#ifndef PAGEDVECTOR_H
+#define PAGEDVECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PageArena.hpp"
+
+/**
+ * @brief Vector of elements stored in fixed-size pages from the page_arena.
+ *
+ * Growing adds pages and never moves the elements already stored, so
+ * references stay valid until the element itself is erased. Every storage
+ * uses the same number of elements per page, so the i-th element of two
+ * vectors is always at the same page and offset: a run of elements that does
+ * not cross a page boundary is contiguous in both.
+ */
+template <typename T>
+class paged_vector {
+public:
+    static constexpr std::size_t page_size = 1024;
+
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using owner = std::conditional_t<Const, const paged_vector*, paged_vector*>;
+
+        basic_iterator() = default;
+        basic_iterator(owner vector, std::size_t index) : _vector(vector), _index(index) {}
+        operator basic_iterator<true>() const { return {_vector, _index}; }
+
+        reference operator*() const { return (*_vector)[_index]; }
+        pointer operator->() const { return &(*_vector)[_index]; }
+        reference operator[](difference_type n) const { return (*_vector)[_index + n]; }
+
+        basic_iterator& operator++() { ++_index; return *this; }
+        basic_iterator operator++(int) { basic_iterator it = *this; ++_index; return it; }
+        basic_iterator& operator--() { --_index; return *this; }
+        basic_iterator operator--(int) { basic_iterator it = *this; --_index; return it; }
+        basic_iterator& operator+=(difference_type n) { _index += n; return *this; }
+        basic_iterator& operator-=(difference_type n) { _index -= n; return *this; }
+        basic_iterator operator+(difference_type n) const { return {_vector, _index + n}; }
+        basic_iterator operator-(difference_type n) const { return {_vector, _index - n}; }
+        difference_type operator-(const basic_iterator& other) const {
+            return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+        }
+
+        bool operator==(const basic_iterator& other) const { return _index == other._index; }
+        bool operator!=(const basic_iterator& other) const { return _index != other._index; }
+        bool operator<(const basic_iterator& other) const { return _index < other._index; }
+        bool operator>(const basic_iterator& other) const { return _index > other._index; }
+        bool operator<=(const basic_iterator& other) const { return _index <= other._index; }
+        bool operator>=(const basic_iterator& other) const { return _index >= other._index; }
+
+    private:
+        owner _vector = nullptr;
+        std::size_t _index = 0;
+    };
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    paged_vector() = default;
+
+    paged_vector(const paged_vector& other) {
+        reserve(other._size);
+        for (const T& value : other) {
+            push_back(value);
+        }
+    }
+
+    paged_vector(paged_vector&& other) noexcept
+        : _pages(std::move(other._pages)), _size(other._size) {
+        other._pages.clear();
+        other._size = 0;
+    }
+
+    ~paged_vector() {
+        clear();
+        release_pages(0);
+    }
+
+    paged_vector& operator=(const paged_vector& other) {
+        if (this != &other) {
+            paged_vector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    paged_vector& operator=(paged_vector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release_pages(0);
+            _pages = std::move(other._pages);
+            _size = other._size;
+            other._pages.clear();
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    void swap(paged_vector& other) noexcept {
+        _pages.swap(other._pages);
+        std::swap(_size, other._size);
+    }
+
+    T& operator[](size_type i) { return _pages[i / page_size][i % page_size]; }
+    const T& operator[](size_type i) const { return _pages[i / page_size][i % page_size]; }
+
+    T& back() { return (*this)[_size - 1]; }
+    const T& back() const { return (*this)[_size - 1]; }
+
+    iterator begin() { return {this, 0}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator cbegin() const { return {this, 0}; }
+    iterator end() { return {this, _size}; }
+    const_iterator end() const { return {this, _size}; }
+    const_iterator cend() const { return {this, _size}; }
+
+    size_type size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    size_type capacity() const { return _pages.size() * page_size; }
+
+    // Address of element i; elements up to the end of its page follow it contiguously.
+    T* at_page(size_type i) { return &(*this)[i]; }
+    const T* at_page(size_type i) const { return &(*this)[i]; }
+
+    // Allocates the pages for n elements up front.
+    void reserve(size_type n) {
+        while (capacity() < n) {
+            _pages.push_back(static_cast<T*>(page_arena::shared().allocate(page_bytes)));
+        }
+    }
+
+    // Calls f(data, count) for the contiguous runs holding the elements, in order.
+    template <typename Function>
+    void for_each_run(Function&& f) const {
+        for (size_type first = 0; first < _size; first += page_size) {
+            f(at_page(first), _size - first < page_size ? _size - first : page_size);
+        }
+    }
+
+    // Appends count elements copied from raw memory, one memcpy per page run.
+    void append_raw(const void* src, size_type count) {
+        static_assert(std::is_trivially_copyable_v<T>, "append_raw() copies the element bytes");
+        reserve(_size + count);
+        const unsigned char* bytes = static_cast<const unsigned char*>(src);
+        while (count != 0) {
+            size_type run = page_size - _size % page_size;
+            run = run < count ? run : count;
+            std::memcpy(at_page(_size), bytes, run * sizeof(T));
+            bytes += run * sizeof(T);
+            _size += run;
+            count -= run;
+        }
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        reserve(_size + 1);
+        T* slot = &(*this)[_size];
+        if constexpr (std::is_aggregate_v<T>) {
+            new (slot) T{std::forward<Args>(args)...};
+        } else {
+            new (slot) T(std::forward<Args>(args)...);
+        }
+        ++_size;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        --_size;
+        (*this)[_size].~T();
+    }
+
+    // Default-constructs elements up to n; never shrinks.
+    void grow_to(size_type n) {
+        while (_size < n) {
+            emplace_back();
+        }
+    }
+
+    void clear() {
+        while (_size != 0) {
+            pop_back();
+        }
+    }
+
+    // Destroys the elements from n up and gives their unused pages back to the arena.
+    void shrink_to(size_type n) {
+        while (_size > n) {
+            pop_back();
+        }
+        release_pages((_size + page_size - 1) / page_size);
+    }
+
+private:
+    static constexpr std::size_t page_bytes = sizeof(T) * page_size;
+
+    void release_pages(size_type keep) {
+        while (_pages.size() > keep) {
+            page_arena::shared().deallocate(_pages.back(), page_bytes);
+            _pages.pop_back();
+        }
+    }
+
+    std::vector<T*> _pages;
+    size_type _size = 0;
+};
+
+#endif // PAGEDVECTOR_H
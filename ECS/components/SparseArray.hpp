@@ -5,14 +5,16 @@
 #include <optional>
 #include <memory>
 #include <algorithm>
+#include "PagedVector.hpp"
 
+// One optional slot per entity id, in arena pages: growing never moves components.
 template <typename Component>
 class sparse_array {
 public:
     using value_type = std::optional<Component>;
     using reference_type = value_type&;
     using const_reference_type = const value_type&;
-    using container_t = std::vector<value_type>;
+    using container_t = paged_vector<value_type>;
     using size_type = typename container_t::size_type;
     using iterator = typename container_t::iterator;
     using const_iterator = typename container_t::const_iterator;
@@ -26,9 +28,7 @@ public:
     sparse_array& operator=(sparse_array&& other) noexcept = default;
 
     reference_type operator[](size_t idx) {
-        if (idx >= _data.size()) {
-            _data.resize(idx + 1);
-        }
+        _data.grow_to(idx + 1);
         return _data[idx];
     }
 
@@ -45,27 +45,24 @@ public:
 
     size_type size() const { return _data.size(); }
 
+    // Allocates the slots of entity ids below n up front.
+    void reserve(size_type n) { _data.reserve(n); }
+
     reference_type insert_at(size_type pos, const Component& component) {
-        if (pos >= _data.size()) {
-            _data.resize(pos + 1);
-        }
+        _data.grow_to(pos + 1);
         _data[pos] = component;
         return _data[pos];
     }
 
     reference_type insert_at(size_type pos, Component&& component) {
-        if (pos >= _data.size()) {
-            _data.resize(pos + 1);
-        }
+        _data.grow_to(pos + 1);
         _data[pos] = std::move(component);
         return _data[pos];
     }
 
     template <class... Params>
     reference_type emplace_at(size_type pos, Params&&... params) {
-        if (pos >= _data.size()) {
-            _data.resize(pos + 1);
-        }
+        _data.grow_to(pos + 1);
         _data[pos].emplace(std::forward<Params>(params)...);
         return _data[pos];
     }
@@ -84,6 +81,20 @@ public:
         return -1;
     }
 
+    void clear() { _data.clear(); }
+
+    // Gives the component of entity from to entity to, which owns none.
+    void renumber(size_type from, size_type to) {
+        if (contains(from)) {
+            _data.grow_to(to + 1);
+            _data[to] = std::move(_data[from]);
+            _data[from].reset();
+        }
+    }
+
+    // Drops the slots of entity ids from n up, which own no component.
+    void shrink_to(size_type n) { _data.shrink_to(n); }
+
     bool contains(size_type index) const {
         return index < _data.size() && _data[index].has_value();
     }
@@ -4,46 +4,132 @@
 #include "Registry.hpp"
 #include "Position.hpp"
 #include "Collidable.hpp"
-#include "Drawable.hpp"
+#include "Collider.hpp"
 #include "Projectile.hpp"
 #include "Controllable.hpp"
-#include <SFML/Graphics.hpp>
+#include "SpatialGrid.hpp"
 #include <vector>
+#include <map>
+#include <cstdint>
+#include <algorithm>
 #include <iostream>
 
-inline bool check_collision(const sf::RectangleShape& shape1, const sf::RectangleShape& shape2) {
-    return shape1.getGlobalBounds().intersects(shape2.getGlobalBounds());
+// Cell edge of the broad-phase grid, about the size of a ship sprite.
+constexpr float collision_cell_size = 64.0f;
+
+/**
+ * @brief Overlapping collider pairs of one tick, grouped by layer pair.
+ *
+ * Game rules read the pairs of the layers they care about with each(), in a
+ * deterministic order, instead of scanning every entity pair themselves.
+ */
+class collision_pairs {
+public:
+    using pair_list = std::vector<std::pair<size_t, size_t>>;
+
+    void add(std::uint32_t layerA, size_t a, std::uint32_t layerB, size_t b) {
+        if (layerB < layerA) {
+            std::swap(layerA, layerB);
+            std::swap(a, b);
+        }
+        _groups[{layerA, layerB}].emplace_back(a, b);
+        ++_size;
+    }
+
+    // Calls f(a, b) for every pair between the two layers, a being on layerA.
+    template <typename Function>
+    void each(std::uint32_t layerA, std::uint32_t layerB, Function&& f) const {
+        auto it = _groups.find({std::min(layerA, layerB), std::max(layerA, layerB)});
+        if (it == _groups.end()) {
+            return;
+        }
+        for (const auto& [first, second] : it->second) {
+            if (layerA <= layerB) {
+                f(first, second);
+            } else {
+                f(second, first);
+            }
+        }
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+private:
+    std::map<std::pair<std::uint32_t, std::uint32_t>, pair_list> _groups;
+    size_t _size = 0;
+};
+
+namespace collision_detail {
+    // Broad phase: only boxes sharing a grid cell are tested against each other.
+    // Fills the candidate slot indices and the overlapping, layer-compatible
+    // pairs as positions in candidates, sorted.
+    inline void find_overlaps(const dense_array<Position>& positions, const dense_array<Collider>& colliders, const dense_array<Collidable>& collidables,
+        std::vector<size_t>& candidates, std::vector<std::pair<size_t, size_t>>& overlaps) {
+        spatial_grid grid(collision_cell_size);
+        component_view<const Position, const Collider, const Collidable> view(positions, colliders, collidables);
+        view.each([&candidates, &grid](size_t entity, const Position& pos, const Collider& collider, const Collidable& collidable) {
+            if (collidable.is_collidable) {
+                grid.insert(candidates.size(), collision_box(pos, collider));
+                candidates.push_back(entity);
+            }
+        });
+        grid.for_each_pair([&overlaps, &colliders, &candidates](size_t a, size_t b) {
+            if (layers_match(colliders[candidates[a]], colliders[candidates[b]])) {
+                overlaps.emplace_back(a, b);
+            }
+        });
+        std::sort(overlaps.begin(), overlaps.end());
+    }
+}
+
+// Every overlapping pair of the tick in a single pass, grouped by the layers of the two colliders.
+inline collision_pairs find_collisions(const dense_array<Position>& positions, const dense_array<Collider>& colliders, const dense_array<Collidable>& collidables) {
+    std::vector<size_t> candidates;
+    std::vector<std::pair<size_t, size_t>> overlaps;
+    collision_detail::find_overlaps(positions, colliders, collidables, candidates, overlaps);
+    collision_pairs pairs;
+    for (const auto& [a, b] : overlaps) {
+        size_t i = candidates[a];
+        size_t j = candidates[b];
+        pairs.add(colliders[i].layer, i, colliders[j].layer, j);
+    }
+    return pairs;
 }
 
-inline std::vector<std::pair<size_t, size_t>> collision_system(Registry& registry, sparse_array<Position>& positions, sparse_array<Drawable>& drawables, sparse_array<Collidable>& collidables, sparse_array<Controllable>& controllables, sparse_array<Projectile>& projectiles) {
+inline std::vector<std::pair<size_t, size_t>> collision_system(Registry& registry, dense_array<Position>& positions, dense_array<Collider>& colliders, dense_array<Collidable>& collidables, sparse_array<Controllable>& controllables, dense_array<Projectile>& projectiles) {
     std::vector<std::pair<size_t, size_t>> collisions;
-    for (size_t i = 0; i < positions.size() && i < drawables.size() && i < collidables.size(); ++i) {
-        auto& pos = positions[i];
-        auto& drawable = drawables[i];
-        auto& collidable = collidables[i];
-        if (pos && drawable && collidable && collidable->is_collidable) {
-            for (size_t j = i + 1; j < positions.size() && j < drawables.size() && j < collidables.size(); ++j) {
-                auto& otherPos = positions[j];
-                auto& otherDrawable = drawables[j];
-                auto& otherCollidable = collidables[j];
-                if (otherPos && otherDrawable && otherCollidable && otherCollidable->is_collidable) {
-                    if (check_collision(drawable->shape, otherDrawable->shape)) {
-                        collisions.emplace_back(i, j); // Record collision
-                        if (controllables[i] || controllables[j]) {
-                            registry.kill_entity(controllables[i] ? i : j);
-                        }
-                        if (projectiles[i] || projectiles[j]) {
-                            registry.kill_entity(projectiles[i] ? j : i);
-                            registry.kill_entity(projectiles[i] ? i : j);
-                        } else {
-                            if (!controllables[i] && !controllables[j]) {
-                                registry.kill_entity(i);
-                                registry.kill_entity(j);
-                            }
-                        }
-                    }
-                }
-            }
+    std::vector<size_t> candidates;
+    std::vector<std::pair<size_t, size_t>> overlaps;
+    // Resolving in candidate order keeps the kills of the exhaustive pair loop.
+    collision_detail::find_overlaps(positions, colliders, collidables, candidates, overlaps);
+
+    // Kills go through the command buffer: erasing from a dense_array moves its last element.
+    std::vector<bool> killed(candidates.size(), false);
+    auto kill = [&registry, &killed, &candidates](size_t candidate) {
+        if (!killed[candidate]) {
+            killed[candidate] = true;
+            registry.commands().kill(registry.entity_from_index(candidates[candidate]));
+        }
+    };
+    for (const auto& [a, b] : overlaps) {
+        if (killed[a] || killed[b]) {
+            continue;
+        }
+        size_t i = candidates[a];
+        size_t j = candidates[b];
+        collisions.emplace_back(std::min(i, j), std::max(i, j)); // Record collision
+        bool controllableI = controllables.contains(i);
+        bool controllableJ = controllables.contains(j);
+        if (controllableI || controllableJ) {
+            kill(controllableI ? a : b);
+        }
+        if (projectiles.contains(i) || projectiles.contains(j)) {
+            kill(a);
+            kill(b);
+        } else if (!controllableI && !controllableJ) {
+            kill(a);
+            kill(b);
         }
     }
     return collisions; // Return list of collisions
@@ -13,15 +13,11 @@
 #include "Drawable.hpp"
 #include <SFML/Graphics.hpp>
 
-inline void draw_system(Registry& registry, sf::RenderWindow& window, sparse_array<Position>& positions, sparse_array<Drawable>& drawables) {
-    for (size_t i = 0; i < positions.size() && i < drawables.size(); ++i) {
-        auto& pos = positions[i];
-        auto& drawable = drawables[i];
-        if (pos && drawable) {
-            drawable->shape.setPosition(pos->x, pos->y);
-            window.draw(drawable->shape);
-        }
-    }
+inline void draw_system(Registry& registry, sf::RenderWindow& window, dense_array<Position>& positions, dense_array<Drawable>& drawables) {
+    component_view<const Position, Drawable>(positions, drawables).each([&window](const Position& pos, Drawable& drawable) {
+        drawable.shape.setPosition(pos.x, pos.y);
+        window.draw(drawable.shape);
+    });
 }
 
 #endif // DRAWSYSTEM_H
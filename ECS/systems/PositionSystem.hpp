@@ -11,16 +11,40 @@
 #include "Registry.hpp"
 #include "Position.hpp"
 #include "Velocity.hpp"
+#include "Integration.hpp"
 
-inline void position_system(Registry& registry, sparse_array<Position>& positions, sparse_array<Velocity>& velocities) {
-    for (size_t i = 0; i < positions.size() && i < velocities.size(); ++i) {
-        auto& pos = positions[i];
-        auto& vel = velocities[i];
-        if (pos && vel) {
-            pos->x += vel->vx;
-            pos->y += vel->vy;
-        }
+static_assert(sizeof(Position) == 2 * sizeof(float) && sizeof(Velocity) == 2 * sizeof(float),
+    "the integration kernel reads Position and Velocity pools as float pairs");
+
+// Streams the Position/Velocity group through the SIMD kernel when the game registered it.
+inline void position_system(Registry& registry, dense_array<Position>& positions, const dense_array<Velocity>& velocities) {
+    if (registry.has_group<Position, Velocity>()) {
+        auto moving = registry.group<Position, Velocity>();
+        thread_pool& pool = thread_pool::shared();
+        std::size_t chunk = std::min(ecs_detail::chunk_size<dense_array<Position>>(moving.size(), pool.size() + 1), dense_array<Position>::page_size);
+        pool.parallel_for(moving.size(), chunk, [&moving, &positions](std::size_t begin, std::size_t end) {
+            moving.for_each_run(begin, end, [&moving, &positions](std::size_t first, std::size_t count) {
+                const Velocity* vel = moving.data<Velocity>(first);
+                integration::integrate(reinterpret_cast<float*>(moving.data<Position>(first)),
+                    reinterpret_cast<const float*>(vel), count);
+                // Only entities that actually moved count as changed.
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (vel[i].vx != 0.0f || vel[i].vy != 0.0f) {
+                        positions.touch(first + i);
+                    }
+                }
+            });
+        });
+        return;
     }
+    // Entities are distinct across the threads, so each touch() stamps its own slot.
+    component_view<Position, const Velocity>(positions, velocities).parallel_each([&positions](std::size_t entity, Position& pos, const Velocity& vel) {
+        if (vel.vx != 0.0f || vel.vy != 0.0f) {
+            pos.x += vel.vx;
+            pos.y += vel.vy;
+            positions.touch(positions.get_index(entity));
+        }
+    });
 }
 
 #endif // POSITIONSYSTEM_H
\ No newline at end of file
@@ -11,41 +11,89 @@
 #include "Registry.hpp"
 #include "Position.hpp"
 #include "Projectile.hpp"
-#include "Drawable.hpp"
+#include "Collider.hpp"
 #include "Collidable.hpp"
 #include "Velocity.hpp"
-#include <iostream>
-
-inline void projectile_system(Registry& registry, sparse_array<Position>& positions, sparse_array<Velocity>& velocities, sparse_array<Projectile>& projectiles, sparse_array<Drawable>& drawables, sparse_array<Collidable>& collidables) {
-    for (size_t i = 0; i < positions.size() && i < velocities.size() && i < projectiles.size() && i < drawables.size() && i < collidables.size(); ++i) {
-        auto& pos = positions[i];
-        auto& vel = velocities[i];
-        auto& proj = projectiles[i];
-        auto& drawable = drawables[i];
-        auto& collidable = collidables[i];
-        if (pos && vel && proj && drawable && collidable) {
-            pos->x += vel->vx * proj->speed;
-            pos->y += vel->vy * proj->speed;
-            std::cout << "Projectile " << i << " position: (" << pos->x << ", " << pos->y << ")" << std::endl;
-            if (pos->x > 800) {
-                std::cout << "Killing entity " << i << std::endl;
-                registry.kill_entity(i);
-                continue;
-            }
-            for (size_t j = 0; j < positions.size() && j < drawables.size() && j < collidables.size(); ++j) {
-                if (i == j) continue;
-                auto& otherPos = positions[j];
-                auto& otherDrawable = drawables[j];
-                auto& otherCollidable = collidables[j];
-                if (otherPos && otherDrawable && otherCollidable && otherCollidable->is_collidable) {
-                    if (drawable->shape.getGlobalBounds().intersects(otherDrawable->shape.getGlobalBounds())) {
-                        std::cout << "Collision detected between " << i << " and " << j << std::endl;
-                        registry.kill_entity(i);
-                        registry.kill_entity(j);
-                        break;
-                    }
+#include "Integration.hpp"
+#include "CollisionSystem.hpp"
+#include <vector>
+#include <algorithm>
+
+// Moves every Position/Velocity/Projectile entity by its velocity times its
+// speed, in one SIMD pass when the game registered their group. Only the
+// entities that actually moved are stamped as changed.
+inline void move_projectiles(Registry& registry, dense_array<Position>& positions, const dense_array<Velocity>& velocities, const dense_array<Projectile>& projectiles) {
+    if (registry.has_group<Position, Velocity, Projectile>()) {
+        static_assert(sizeof(Projectile) == sizeof(float), "the integration kernel reads Projectile::speed as a float array");
+        auto moving = registry.group<Position, Velocity, Projectile>();
+        moving.for_each_run(0, moving.size(), [&moving, &positions](std::size_t first, std::size_t count) {
+            integration::integrate_scaled(reinterpret_cast<float*>(moving.data<Position>(first)),
+                reinterpret_cast<const float*>(moving.data<Velocity>(first)),
+                reinterpret_cast<const float*>(moving.data<Projectile>(first)), count);
+            const Velocity* vel = moving.data<Velocity>(first);
+            const Projectile* proj = moving.data<Projectile>(first);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (proj[i].speed != 0.0f && (vel[i].vx != 0.0f || vel[i].vy != 0.0f)) {
+                    positions.touch(first + i);
                 }
             }
+        });
+        return;
+    }
+    component_view<Position, const Velocity, const Projectile>(positions, velocities, projectiles)
+        .each([&positions](size_t i, Position& pos, const Velocity& vel, const Projectile& proj) {
+        if (proj.speed != 0.0f && (vel.vx != 0.0f || vel.vy != 0.0f)) {
+            pos.x += vel.vx * proj.speed;
+            pos.y += vel.vy * proj.speed;
+            positions.touch(positions.get_index(i));
+        }
+    });
+}
+
+// Moves every Position/Velocity/Projectile entity and kills those past
+// x = 800. A hit follows the rule of collision_system: both entities are
+// collidable and each one's Collider layer is in the other's mask. Both the
+// projectile and its first target die.
+inline void projectile_system(Registry& registry, dense_array<Position>& positions, dense_array<Velocity>& velocities, dense_array<Projectile>& projectiles, dense_array<Collider>& colliders, dense_array<Collidable>& collidables) {
+    move_projectiles(registry, positions, velocities, projectiles);
+
+    std::vector<size_t> offscreen;
+    component_view<const Position, const Velocity, const Projectile>(positions, velocities, projectiles)
+        .each([&offscreen](size_t i, const Position& pos, const Velocity&, const Projectile&) {
+        if (pos.x > 800) {
+            offscreen.push_back(i);
+        }
+    });
+    std::sort(offscreen.begin(), offscreen.end());
+    auto isOffscreen = [&offscreen](size_t entity) {
+        return std::binary_search(offscreen.begin(), offscreen.end(), entity);
+    };
+    auto isProjectile = [&velocities, &projectiles](size_t entity) {
+        return velocities.contains(entity) && projectiles.contains(entity);
+    };
+
+    // Hits come from the same single broad-phase pass as collision_system.
+    std::vector<size_t> candidates;
+    std::vector<std::pair<size_t, size_t>> overlaps;
+    collision_detail::find_overlaps(positions, colliders, collidables, candidates, overlaps);
+    std::vector<bool> killed(candidates.size(), false);
+    for (const auto& [a, b] : overlaps) {
+        size_t i = candidates[a];
+        size_t j = candidates[b];
+        if (killed[a] || killed[b] || isOffscreen(i) || isOffscreen(j) || (!isProjectile(i) && !isProjectile(j))) {
+            continue;
+        }
+        killed[a] = true;
+        killed[b] = true;
+    }
+
+    // Kills go through the command buffer: erasing from a dense_array moves its last element.
+    for (size_t entity : offscreen) {
+        registry.commands().kill(registry.entity_from_index(entity));
+    }
+    for (size_t candidate = 0; candidate < candidates.size(); ++candidate) {
+        if (killed[candidate]) {
+            registry.commands().kill(registry.entity_from_index(candidates[candidate]));
         }
     }
 }
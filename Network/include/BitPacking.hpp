@@ -0,0 +1,102 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** BitPacking
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Network {
+    // Writes values of any bit width into a caller buffer, least significant bit
+    // first. Running out of room sets overflowed() and drops the rest.
+    class BitWriter {
+    public:
+        BitWriter(uint8_t* out, size_t capacity) : m_out(out), m_capacity(capacity) {}
+
+        void write(uint32_t value, unsigned bits) {
+            for (unsigned i = 0; i < bits; ++i, ++m_bit) {
+                size_t byte = m_bit >> 3;
+                if (byte >= m_capacity) {
+                    m_overflow = true;
+                    return;
+                }
+                if ((m_bit & 7) == 0)
+                    m_out[byte] = 0;
+                m_out[byte] |= static_cast<uint8_t>(((value >> i) & 1) << (m_bit & 7));
+            }
+        }
+
+        // Exp-Golomb code of value: small values take few bits, 0 takes one.
+        void writeGamma(uint32_t value) {
+            uint64_t coded = static_cast<uint64_t>(value) + 1;
+            unsigned length = 0;
+            while ((coded >> (length + 1)) != 0)
+                ++length;
+            write(0, length);
+            write(1, 1);
+            write(static_cast<uint32_t>(coded), length);
+        }
+
+        void writeSigned(int32_t value) {
+            writeGamma((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+        }
+
+        size_t bytes() const { return (m_bit + 7) >> 3; }
+        bool overflowed() const { return m_overflow; }
+
+    private:
+        uint8_t* m_out;
+        size_t m_capacity;
+        size_t m_bit = 0;
+        bool m_overflow = false;
+    };
+
+    // Reads back what a BitWriter wrote. Reading past the end returns zeros and
+    // sets failed().
+    class BitReader {
+    public:
+        BitReader(const uint8_t* in, size_t size) : m_in(in), m_size(size) {}
+
+        uint32_t read(unsigned bits) {
+            uint32_t value = 0;
+            for (unsigned i = 0; i < bits; ++i, ++m_bit) {
+                size_t byte = m_bit >> 3;
+                if (byte >= m_size) {
+                    m_failed = true;
+                    return 0;
+                }
+                value |= static_cast<uint32_t>((m_in[byte] >> (m_bit & 7)) & 1) << i;
+            }
+            return value;
+        }
+
+        uint32_t readGamma() {
+            unsigned length = 0;
+            while (read(1) == 0) {
+                if (m_failed || ++length > 32) {
+                    m_failed = true;
+                    return 0;
+                }
+            }
+            uint64_t coded = (static_cast<uint64_t>(1) << length) | read(length);
+            return static_cast<uint32_t>(coded - 1);
+        }
+
+        int32_t readSigned() {
+            uint32_t zigzag = readGamma();
+            return static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+        }
+
+        bool failed() const { return m_failed; }
+
+    private:
+        const uint8_t* m_in;
+        size_t m_size;
+        size_t m_bit = 0;
+        bool m_failed = false;
+    };
+}
@@ -0,0 +1,257 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** Codec
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "WireProtocol.hpp"
+
+namespace Network {
+    // Tag of the codec a datagram was packed with, its first byte.
+    enum class CodecId : uint8_t {
+        Raw = 0,
+        Lz = 1
+    };
+
+    /**
+     * @brief Compression scheme of the datagrams.
+     *
+     * A codec keeps whatever state it needs between calls (tables, windows)
+     * and reuses it for every datagram. Both calls work in buffers given by
+     * the caller.
+     */
+    class Codec {
+    public:
+        virtual ~Codec() = default;
+
+        virtual CodecId id() const = 0;
+        // Largest output of compress() for size input bytes.
+        virtual size_t compressBound(size_t size) const = 0;
+        // Returns the compressed size, or 0 when out is too small.
+        virtual size_t compress(const uint8_t* in, size_t size, uint8_t* out, size_t capacity) = 0;
+        // Returns the decompressed size, or 0 on malformed input or when out is too small.
+        virtual size_t decompress(const uint8_t* in, size_t size, uint8_t* out, size_t capacity) = 0;
+    };
+
+    class RawCodec : public Codec {
+    public:
+        CodecId id() const override { return CodecId::Raw; }
+
+        size_t compressBound(size_t size) const override { return size; }
+
+        size_t compress(const uint8_t* in, size_t size, uint8_t* out, size_t capacity) override {
+            if (size > capacity)
+                return 0;
+            std::memcpy(out, in, size);
+            return size;
+        }
+
+        size_t decompress(const uint8_t* in, size_t size, uint8_t* out, size_t capacity) override {
+            return compress(in, size, out, capacity);
+        }
+    };
+
+    /**
+     * @brief LZ77 codec in the LZ4 block layout, primed with a dictionary.
+     *
+     * A block is a list of sequences:
+     *   token     4 bits literal count, 4 bits match length - 4
+     *             (15 means more: bytes of 255 and a last one below it follow)
+     *   literals
+     *   u16 LE    match offset, back into the output or into the dictionary
+     * The last sequence has literals only.
+     *
+     * Datagrams are too short for a match to be found within one of them, so
+     * matches mostly point into the dictionary: byte strings every peer sees
+     * often, such as frame headers and control records. The hash table of the
+     * dictionary is built once and restored before every datagram.
+     */
+    class LzCodec : public Codec {
+    public:
+        LzCodec() : LzCodec(dictionary()) {}
+
+        // Both ends must be primed with the same bytes; empty means no dictionary.
+        explicit LzCodec(std::vector<uint8_t> primer) : m_dictionary(std::move(primer)), m_window(m_dictionary) {
+            m_primed.assign(tableSize, noPosition);
+            for (size_t i = 0; i + minMatch <= m_dictionary.size(); ++i)
+                m_primed[hash(m_dictionary.data() + i)] = static_cast<uint32_t>(i);
+            m_table = m_primed;
+        }
+
+        CodecId id() const override { return CodecId::Lz; }
+
+        size_t compressBound(size_t size) const override {
+            return size + size / 255 + 16;
+        }
+
+        size_t compress(const uint8_t* in, size_t size, uint8_t* out, size_t capacity) override {
+            size_t base = m_dictionary.size();
+            m_window.resize(base);
+            m_window.insert(m_window.end(), in, in + size);
+            std::memcpy(m_table.data(), m_primed.data(), tableSize * sizeof(uint32_t));
+            const uint8_t* window = m_window.data();
+            size_t end = base + size;
+            size_t written = 0;
+            size_t anchor = base;
+            size_t pos = base;
+
+            // The last bytes always go as literals, as in LZ4.
+            while (size >= minMatch + lastLiterals && pos + minMatch + lastLiterals <= end) {
+                uint32_t& slot = m_table[hash(window + pos)];
+                size_t candidate = slot;
+                slot = static_cast<uint32_t>(pos);
+                if (candidate == noPosition || pos - candidate > maxOffset || std::memcmp(window + candidate, window + pos, minMatch) != 0) {
+                    ++pos;
+                    continue;
+                }
+                size_t length = minMatch;
+                while (pos + length + lastLiterals < end && window[candidate + length] == window[pos + length])
+                    ++length;
+                if (!writeSequence(out, capacity, written, window + anchor, pos - anchor, pos - candidate, length))
+                    return 0;
+                pos += length;
+                anchor = pos;
+            }
+            if (!writeSequence(out, capacity, written, window + anchor, end - anchor, 0, 0))
+                return 0;
+            return written;
+        }
+
+        size_t decompress(const uint8_t* in, size_t size, uint8_t* out, size_t capacity) override {
+            size_t read = 0;
+            size_t written = 0;
+            while (read < size) {
+                uint8_t token = in[read++];
+                size_t literals = token >> 4;
+                if (literals == 15 && !readLength(in, size, read, literals))
+                    return 0;
+                if (literals > size - read || literals > capacity - written)
+                    return 0;
+                std::memcpy(out + written, in + read, literals);
+                read += literals;
+                written += literals;
+                if (read == size)
+                    break;
+
+                if (size - read < 2)
+                    return 0;
+                size_t offset = Wire::detail::get16(in + read);
+                read += 2;
+                size_t length = token & 15;
+                if (length == 15 && !readLength(in, size, read, length))
+                    return 0;
+                length += minMatch;
+                if (offset == 0 || offset > written + m_dictionary.size() || length > capacity - written)
+                    return 0;
+                // Byte by byte: a match may overlap the bytes it produces.
+                for (size_t i = 0; i < length; ++i, ++written) {
+                    out[written] = offset > written ? m_dictionary[m_dictionary.size() - (offset - written)] : out[written - offset];
+                }
+            }
+            return written;
+        }
+
+        /**
+         * @brief Byte strings the datagrams of this game are made of.
+         *
+         * Built from the wire format itself so that both ends derive the same
+         * bytes: frame and control headers and the records they usually carry.
+         * Client packets are a few bytes and never reach the codec.
+         */
+        static std::vector<uint8_t> dictionary() {
+            std::vector<uint8_t> bytes;
+            auto addRecords = [&bytes](PacketType type, uint32_t frameId, const EntityRecord* records, size_t count) {
+                uint8_t buffer[Wire::headerSize + 2 * Wire::recordSize];
+                size_t size = Wire::encode(buffer, sizeof(buffer), type, frameId, records, count);
+                bytes.insert(bytes.end(), buffer, buffer + size);
+            };
+            for (PacketType type : {PacketType::GAME_STARTED, PacketType::GAME_NOT_STARTED, PacketType::LATENCY_CHECK, PacketType::NONE}) {
+                EntityRecord record{type, -1, -1.0f, -1.0f};
+                addRecords(type, 0, &record, 1);
+            }
+            EntityRecord background[] = {
+                {PacketType::CREATE_BACKGROUND, -100, 0.0f, 0.0f},
+                {PacketType::IMPORTANT_PACKET, -1, -1.0f, -1.0f},
+            };
+            addRecords(PacketType::FRAME, 0, background, 2);
+            EntityRecord win{PacketType::WIN, -1, -1.0f, -1.0f};
+            addRecords(PacketType::FRAME, 0, &win, 1);
+            addRecords(PacketType::FRAME, 0, nullptr, 0);
+            return bytes;
+        }
+
+    private:
+        static constexpr size_t minMatch = 4;
+        static constexpr size_t lastLiterals = 5;
+        static constexpr size_t maxOffset = UINT16_MAX;
+        static constexpr unsigned tableBits = 10;
+        static constexpr size_t tableSize = size_t(1) << tableBits;
+        static constexpr uint32_t noPosition = UINT32_MAX;
+
+        static uint32_t hash(const uint8_t* at) {
+            uint32_t value;
+            std::memcpy(&value, at, sizeof(value));
+            return (value * 2654435761u) >> (32 - tableBits);
+        }
+
+        static bool writeLength(uint8_t* out, size_t capacity, size_t& written, size_t length) {
+            for (; length >= 255; length -= 255) {
+                if (written == capacity)
+                    return false;
+                out[written++] = 255;
+            }
+            if (written == capacity)
+                return false;
+            out[written++] = static_cast<uint8_t>(length);
+            return true;
+        }
+
+        static bool readLength(const uint8_t* in, size_t size, size_t& read, size_t& length) {
+            uint8_t byte;
+            do {
+                if (read == size)
+                    return false;
+                byte = in[read++];
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+        // A match length of 0 ends the block with literals only.
+        static bool writeSequence(uint8_t* out, size_t capacity, size_t& written, const uint8_t* literals, size_t literalCount, size_t offset, size_t length) {
+            if (written == capacity)
+                return false;
+            size_t token = written++;
+            size_t matchCode = length ? length - minMatch : 0;
+            out[token] = static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+            if (literalCount >= 15 && !writeLength(out, capacity, written, literalCount - 15))
+                return false;
+            if (literalCount > capacity - written)
+                return false;
+            std::memcpy(out + written, literals, literalCount);
+            written += literalCount;
+            if (!length)
+                return true;
+            if (capacity - written < 2)
+                return false;
+            Wire::detail::put16(out + written, static_cast<uint16_t>(offset));
+            written += 2;
+            return matchCode < 15 || writeLength(out, capacity, written, matchCode - 15);
+        }
+
+        std::vector<uint8_t> m_dictionary;
+        std::vector<uint8_t> m_window;
+        std::vector<uint32_t> m_primed;
+        std::vector<uint32_t> m_table;
+    };
+}
@@ -8,36 +8,92 @@
 #ifndef DATAPACKING_HPP
 #define DATAPACKING_HPP
 
+#include <atomic>
 #include <string>
-#include <sstream>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#include <boost/iostreams/filter/gzip.hpp>
-#include <boost/iostreams/copy.hpp>
+#include <vector>
 
+#include "Codec.hpp"
+
+/**
+ * @brief Packs datagrams for the socket: one byte naming the codec, then the payload.
+ *
+ * Datagrams below rawThreshold, and those the codec does not shrink, go raw.
+ * Every thread keeps its own codecs, so their tables and buffers are reused
+ * from one datagram to the next without locking.
+ */
 class DataPacking {
 public:
-    static std::string compressData(const std::string& data) {
-        std::stringstream compressed;
-        std::stringstream original(data);
+    // Below this size no codec wins back its cost.
+    static constexpr size_t rawThreshold = 32;
+    // Largest unpacked datagram.
+    static constexpr size_t maxDatagram = 65536;
 
-        boost::iostreams::filtering_streambuf<boost::iostreams::output> out;
-        out.push(boost::iostreams::gzip_compressor());
-        out.push(compressed);
+    // Codec compressData() packs with; decompressData() reads any of them.
+    static void setCodec(Network::CodecId id) {
+        codecId() = id;
+    }
+
+    static std::string compressData(const std::string& data) {
+        const uint8_t* in = reinterpret_cast<const uint8_t*>(data.data());
+        Network::Codec& codec = codecs().get(data.size() < rawThreshold ? Network::CodecId::Raw : codecId().load());
+        std::string packed(1 + codec.compressBound(data.size()), '\0');
+        uint8_t* out = reinterpret_cast<uint8_t*>(packed.data());
 
-        boost::iostreams::copy(original, out);
-        return compressed.str();
+        size_t size = codec.compress(in, data.size(), out + 1, packed.size() - 1);
+        if (codec.id() != Network::CodecId::Raw && (size == 0 || size >= data.size())) {
+            packed.resize(1 + data.size());
+            out = reinterpret_cast<uint8_t*>(packed.data());
+            size = codecs().get(Network::CodecId::Raw).compress(in, data.size(), out + 1, data.size());
+            out[0] = static_cast<uint8_t>(Network::CodecId::Raw);
+        } else
+            out[0] = static_cast<uint8_t>(codec.id());
+        packed.resize(1 + size);
+        return packed;
     }
 
+    // Returns an empty string for a datagram that does not unpack.
     static std::string decompressData(const std::string& compressed) {
-        std::stringstream decompressed;
-        std::stringstream compressedStream(compressed);
+        if (compressed.empty())
+            return {};
+        Network::Codec* codec = codecs().find(static_cast<uint8_t>(compressed[0]));
+        if (!codec)
+            return {};
+        Codecs& context = codecs();
+        size_t size = codec->decompress(reinterpret_cast<const uint8_t*>(compressed.data()) + 1, compressed.size() - 1,
+            context.buffer.data(), context.buffer.size());
+        return std::string(reinterpret_cast<const char*>(context.buffer.data()), size);
+    }
+
+private:
+    // The codecs of a thread, by id, and its unpacking buffer.
+    struct Codecs {
+        Network::RawCodec raw;
+        Network::LzCodec lz;
+        std::vector<uint8_t> buffer = std::vector<uint8_t>(maxDatagram);
+
+        Network::Codec* find(uint8_t id) {
+            switch (static_cast<Network::CodecId>(id)) {
+            case Network::CodecId::Raw:
+                return &raw;
+            case Network::CodecId::Lz:
+                return &lz;
+            }
+            return nullptr;
+        }
 
-        boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
-        in.push(boost::iostreams::gzip_decompressor());
-        in.push(compressedStream);
+        Network::Codec& get(Network::CodecId id) {
+            return *find(static_cast<uint8_t>(id));
+        }
+    };
+
+    static Codecs& codecs() {
+        thread_local Codecs perThread;
+        return perThread;
+    }
 
-        boost::iostreams::copy(in, decompressed);
-        return decompressed.str();
+    static std::atomic<Network::CodecId>& codecId() {
+        static std::atomic<Network::CodecId> id{Network::CodecId::Lz};
+        return id;
     }
 };
 
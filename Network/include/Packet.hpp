@@ -12,6 +12,7 @@
 
 #include <variant>
 #include <string>
+#include <boost/asio/ip/udp.hpp>
 
 namespace Network {
 
@@ -30,6 +31,8 @@ namespace Network {
             BossData
         > data;
         std::string rawData;
+        // Sender of the datagram.
+        boost::asio::ip::udp::endpoint endpoint;
     };
 }
 
@@ -16,11 +16,12 @@
 #include "PacketType.hpp"
 #include "GameState.hpp"
 #include "Server.hpp"
+#include "MatchManager.hpp"
 
 namespace Network {
     class PacketHandler {
     public:
-        PacketHandler(ThreadSafeQueue<Network::Packet>& queue, AGame& game, RType::Server& server);
+        PacketHandler(ThreadSafeQueue<Network::Packet>& queue, RType::MatchManager& matches, RType::Server& server);
         ~PacketHandler();
 
         void start();
@@ -54,13 +55,14 @@ namespace Network {
         void handleOpenMenu(const Network::Packet &packet);
         void handlePlayerAction(const Network::Packet &packet, int action);
         void handleImportantPacketReceived(const Network::Packet &packet);
+        void handleFrameAck(const Network::Packet &packet);
 
         std::string compressData(const std::string& data);
         std::string decompressData(const std::string& compressed);
 
     private:
         ThreadSafeQueue<Network::Packet> &m_queue;
-        AGame& m_game;
+        RType::MatchManager& m_matches;
         std::thread m_thread;
         RType::Server& m_server;
         std::atomic<bool> m_running{false};
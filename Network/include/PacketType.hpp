@@ -9,8 +9,6 @@
 
 #include <cstdint>
 
-#include "Packet.hpp"
-
 namespace Network {
     enum class PacketType {
         NONE = 0,
@@ -49,5 +47,7 @@ namespace Network {
         IMPORTANT_PACKET = 33,
         IMPORTANT_PACKET_RECEIVED = 34,
         WIN = 35,
+        FRAME = 36,
+        FRAME_ACK = 37,
     };
 }
@@ -0,0 +1,368 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** WireProtocol
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "BitPacking.hpp"
+#include "PacketType.hpp"
+
+namespace Network {
+    // One entity event of a frame. Control messages carry their value in one too.
+    struct EntityRecord {
+        PacketType type;
+        int32_t id;
+        float x;
+        float y;
+    };
+
+    // Replicated state of an entity: its kind (the CREATE_ type clients build
+    // its sprite from) and its position in quantiser units. Kept in lists
+    // sorted by id.
+    struct EntityState {
+        uint32_t id;
+        PacketType kind;
+        uint16_t x;
+        uint16_t y;
+
+        bool operator==(const EntityState& other) const {
+            return id == other.id && kind == other.kind && x == other.x && y == other.y;
+        }
+    };
+
+    // What an entry of the entity block does to the receiver's state.
+    enum class EntityChange : uint8_t {
+        Moved,
+        Spawned,
+        Removed
+    };
+
+    // Maps playfield coordinates to bits-wide integers. The range is the
+    // 1280x720 screen plus half a screen on every side, for entities entering
+    // or leaving it; positions further out are clamped.
+    struct PositionQuantiser {
+        static constexpr float minX = -640.0f;
+        static constexpr float maxX = 1920.0f;
+        static constexpr float minY = -360.0f;
+        static constexpr float maxY = 1080.0f;
+
+        unsigned bits = 16;
+
+        uint32_t maxValue() const { return (1u << bits) - 1; }
+
+        uint16_t quantiseAxis(float value, float min, float max) const {
+            float scaled = (value - min) / (max - min) * static_cast<float>(maxValue()) + 0.5f;
+            if (!(scaled > 0.0f))
+                return 0;
+            if (scaled >= static_cast<float>(maxValue()))
+                return static_cast<uint16_t>(maxValue());
+            return static_cast<uint16_t>(scaled);
+        }
+
+        EntityState quantise(uint32_t id, PacketType kind, float x, float y) const {
+            return {id, kind, quantiseAxis(x, minX, maxX), quantiseAxis(y, minY, maxY)};
+        }
+
+        float toX(uint16_t x) const { return minX + x * (maxX - minX) / static_cast<float>(maxValue()); }
+        float toY(uint16_t y) const { return minY + y * (maxY - minY) / static_cast<float>(maxValue()); }
+    };
+
+    /**
+     * @brief Binary layout of the datagrams the server sends.
+     *
+     * Every field is little-endian, whatever the host:
+     *   header  u8 version, u8 packet type, u16 record count, u32 frame id,
+     *           u32 baseline frame id, u32 payload length
+     *   record  u8 packet type, i32 entity id, f32 x, f32 y
+     * Frames have the FRAME type. Any other type is a control message
+     * (GAME_STARTED, LATENCY_CHECK...) with frame id 0 and a single record.
+     *
+     * A frame may end with a bit-packed entity block after its records, the
+     * difference between the entities of the frame and of its baseline frame:
+     *   4 bits precision - 1, u16 entry count, then per entry, by increasing id:
+     *   gamma(id gap), 2 bits operation, then
+     *     0 moved    signed gamma deltas from the baseline position
+     *     1 moved    absolute x and y on precision bits
+     *     2 spawned  u8 kind, absolute x and y
+     *     3 removed  nothing
+     * Entities unchanged since the baseline are left out. An id whose kind
+     * changed is a new entity in a recycled slot and is spawned again. With no
+     * baseline (noBaseline) every entity is spawned.
+     *
+     * Encoding and decoding work in buffers given by the caller and never allocate.
+     */
+    namespace Wire {
+        constexpr uint8_t version = 3;
+        constexpr size_t headerSize = 16;
+        constexpr size_t recordSize = 13;
+        constexpr size_t maxRecords = UINT16_MAX;
+        constexpr uint32_t noBaseline = UINT32_MAX;
+        // Frames both ends keep as possible baselines.
+        constexpr size_t baselineHistory = 32;
+
+        struct Header {
+            uint8_t version;
+            PacketType type;
+            uint16_t count;
+            uint32_t frameId;
+            uint32_t baselineId;
+            uint32_t length;
+        };
+
+        namespace detail {
+            inline void put16(uint8_t* out, uint16_t value) {
+                out[0] = static_cast<uint8_t>(value);
+                out[1] = static_cast<uint8_t>(value >> 8);
+            }
+
+            inline void put32(uint8_t* out, uint32_t value) {
+                for (int i = 0; i < 4; ++i)
+                    out[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+
+            inline uint16_t get16(const uint8_t* in) {
+                return static_cast<uint16_t>(in[0] | (in[1] << 8));
+            }
+
+            inline uint32_t get32(const uint8_t* in) {
+                uint32_t value = 0;
+                for (int i = 0; i < 4; ++i)
+                    value |= static_cast<uint32_t>(in[i]) << (8 * i);
+                return value;
+            }
+
+            inline uint32_t floatBits(float value) {
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return bits;
+            }
+
+            inline float bitsFloat(uint32_t bits) {
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+
+            inline unsigned gammaBits(uint32_t value) {
+                uint64_t coded = static_cast<uint64_t>(value) + 1;
+                unsigned length = 0;
+                while ((coded >> (length + 1)) != 0)
+                    ++length;
+                return 2 * length + 1;
+            }
+
+            inline uint32_t zigzag(int32_t value) {
+                return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+            }
+
+            enum Operation : uint32_t {
+                MovedRelative,
+                MovedAbsolute,
+                Spawned,
+                Removed
+            };
+        }
+
+        /**
+         * @brief Walks two entity lists sorted by id and calls f(current, previous)
+         * for every entity that differs.
+         *
+         * current is nullptr for an entity only in previous, and previous for
+         * an entity only in current.
+         */
+        template <typename Function>
+        void forEachDifference(const EntityState* current, size_t count, const EntityState* previous, size_t previousCount, Function&& f) {
+            size_t i = 0;
+            size_t p = 0;
+            while (i < count || p < previousCount) {
+                if (p == previousCount || (i < count && current[i].id < previous[p].id)) {
+                    f(&current[i++], nullptr);
+                } else if (i == count || previous[p].id < current[i].id) {
+                    f(nullptr, &previous[p++]);
+                } else {
+                    if (!(current[i] == previous[p]))
+                        f(&current[i], &previous[p]);
+                    ++i;
+                    ++p;
+                }
+            }
+        }
+
+        inline size_t encodedSize(size_t count) {
+            return headerSize + count * recordSize;
+        }
+
+        // Largest entity block between count entities and baselineCount baseline ones.
+        inline size_t entityBlockBound(size_t count, size_t baselineCount) {
+            return 3 + (count + baselineCount) * 14;
+        }
+
+        // Writes one datagram to out and returns its size, or 0 when it does not fit.
+        inline size_t encode(uint8_t* out, size_t capacity, PacketType type, uint32_t frameId, const EntityRecord* records, size_t count) {
+            size_t size = encodedSize(count);
+            if (count > maxRecords || size > capacity)
+                return 0;
+            out[0] = version;
+            out[1] = static_cast<uint8_t>(type);
+            detail::put16(out + 2, static_cast<uint16_t>(count));
+            detail::put32(out + 4, frameId);
+            detail::put32(out + 8, noBaseline);
+            detail::put32(out + 12, static_cast<uint32_t>(count * recordSize));
+            uint8_t* at = out + headerSize;
+            for (size_t i = 0; i < count; ++i, at += recordSize) {
+                at[0] = static_cast<uint8_t>(records[i].type);
+                detail::put32(at + 1, static_cast<uint32_t>(records[i].id));
+                detail::put32(at + 5, detail::floatBits(records[i].x));
+                detail::put32(at + 9, detail::floatBits(records[i].y));
+            }
+            return size;
+        }
+
+        /**
+         * @brief Appends the entity block to a datagram written by encode().
+         *
+         * current and baseline are sorted by id; baselineId names the frame
+         * the baseline entities were sent in, or is noBaseline. Returns the
+         * new datagram size, or 0 when it does not fit.
+         */
+        inline size_t appendEntities(uint8_t* out, size_t size, size_t capacity, const PositionQuantiser& quantiser, uint32_t baselineId,
+            const EntityState* current, size_t count, const EntityState* baseline, size_t baselineCount) {
+            if (baselineId == noBaseline)
+                baselineCount = 0;
+            size_t changed = 0;
+            forEachDifference(current, count, baseline, baselineCount, [&changed](const EntityState*, const EntityState*) {
+                ++changed;
+            });
+            if (size > capacity || changed > UINT16_MAX)
+                return 0;
+
+            BitWriter bits(out + size, capacity - size);
+            bits.write(quantiser.bits - 1, 4);
+            bits.write(static_cast<uint32_t>(changed), 16);
+            int64_t lastId = -1;
+            forEachDifference(current, count, baseline, baselineCount, [&](const EntityState* entity, const EntityState* previous) {
+                uint32_t id = entity ? entity->id : previous->id;
+                bits.writeGamma(static_cast<uint32_t>(id - lastId - 1));
+                lastId = id;
+                if (!entity) {
+                    bits.write(detail::Removed, 2);
+                    return;
+                }
+                if (!previous || previous->kind != entity->kind) {
+                    bits.write(detail::Spawned, 2);
+                    bits.write(static_cast<uint8_t>(entity->kind), 8);
+                    bits.write(entity->x, quantiser.bits);
+                    bits.write(entity->y, quantiser.bits);
+                    return;
+                }
+                int32_t dx = entity->x - previous->x;
+                int32_t dy = entity->y - previous->y;
+                if (detail::gammaBits(detail::zigzag(dx)) + detail::gammaBits(detail::zigzag(dy)) < 2 * quantiser.bits) {
+                    bits.write(detail::MovedRelative, 2);
+                    bits.writeSigned(dx);
+                    bits.writeSigned(dy);
+                } else {
+                    bits.write(detail::MovedAbsolute, 2);
+                    bits.write(entity->x, quantiser.bits);
+                    bits.write(entity->y, quantiser.bits);
+                }
+            });
+            if (bits.overflowed())
+                return 0;
+            size += bits.bytes();
+            detail::put32(out + 8, baselineId);
+            detail::put32(out + 12, static_cast<uint32_t>(size - headerSize));
+            return size;
+        }
+
+        // Fails on another version or when size does not match the header.
+        inline bool decodeHeader(const uint8_t* data, size_t size, Header& header) {
+            if (size < headerSize || data[0] != version)
+                return false;
+            header.version = data[0];
+            header.type = static_cast<PacketType>(data[1]);
+            header.count = detail::get16(data + 2);
+            header.frameId = detail::get32(data + 4);
+            header.baselineId = detail::get32(data + 8);
+            header.length = detail::get32(data + 12);
+            return header.length >= header.count * recordSize && size == headerSize + header.length;
+        }
+
+        inline bool hasEntities(const Header& header) {
+            return header.length > header.count * recordSize;
+        }
+
+        // Record index of a datagram whose header decoded.
+        inline EntityRecord decodeRecord(const uint8_t* data, size_t index) {
+            const uint8_t* at = data + headerSize + index * recordSize;
+            return {
+                static_cast<PacketType>(at[0]),
+                static_cast<int32_t>(detail::get32(at + 1)),
+                detail::bitsFloat(detail::get32(at + 5)),
+                detail::bitsFloat(detail::get32(at + 9)),
+            };
+        }
+
+        /**
+         * @brief Calls f(EntityChange, EntityState) for every entry of the entity block.
+         *
+         * baseline holds the entities of header.baselineId, sorted by id.
+         * quantiser gets the precision of the block, to turn the entries back
+         * into coordinates. A removed entity is reported with its baseline
+         * state. Returns false on a malformed block or on an entry that needs
+         * a baseline entity which is missing; the entries already reported
+         * stay reported.
+         */
+        template <typename Function>
+        bool decodeEntities(const uint8_t* data, const Header& header, const EntityState* baseline, size_t baselineCount,
+            PositionQuantiser& quantiser, Function&& f) {
+            size_t offset = headerSize + header.count * recordSize;
+            BitReader bits(data + offset, headerSize + header.length - offset);
+            unsigned precision = bits.read(4) + 1;
+            quantiser.bits = precision;
+            uint32_t count = bits.read(16);
+            int64_t lastId = -1;
+            size_t b = 0;
+            for (uint32_t i = 0; i < count && !bits.failed(); ++i) {
+                EntityState entity;
+                entity.id = static_cast<uint32_t>(lastId + 1 + bits.readGamma());
+                lastId = entity.id;
+                uint32_t operation = bits.read(2);
+                while (b < baselineCount && baseline[b].id < entity.id)
+                    ++b;
+                const EntityState* previous = b < baselineCount && baseline[b].id == entity.id ? &baseline[b] : nullptr;
+                EntityChange change = EntityChange::Moved;
+                if (operation == detail::Spawned) {
+                    change = EntityChange::Spawned;
+                    entity.kind = static_cast<PacketType>(bits.read(8));
+                    entity.x = static_cast<uint16_t>(bits.read(precision));
+                    entity.y = static_cast<uint16_t>(bits.read(precision));
+                } else if (!previous) {
+                    return false;
+                } else if (operation == detail::Removed) {
+                    change = EntityChange::Removed;
+                    entity = *previous;
+                } else if (operation == detail::MovedRelative) {
+                    entity.kind = previous->kind;
+                    entity.x = static_cast<uint16_t>(previous->x + bits.readSigned());
+                    entity.y = static_cast<uint16_t>(previous->y + bits.readSigned());
+                } else {
+                    entity.kind = previous->kind;
+                    entity.x = static_cast<uint16_t>(bits.read(precision));
+                    entity.y = static_cast<uint16_t>(bits.read(precision));
+                }
+                if (bits.failed())
+                    return false;
+                f(change, entity);
+            }
+            return !bits.failed();
+        }
+    }
+}
@@ -13,7 +13,7 @@
 using namespace Network;
 
 // Constructor
-PacketHandler::PacketHandler(ThreadSafeQueue<Network::Packet>& queue, AGame& game, RType::Server& server) : m_queue(queue), m_game(game), m_server(server)
+PacketHandler::PacketHandler(ThreadSafeQueue<Network::Packet>& queue, RType::MatchManager& matches, RType::Server& server) : m_queue(queue), m_matches(matches), m_server(server)
 {
     initializeHandlers();
 }
@@ -63,6 +63,7 @@ void PacketHandler::initializeHandlers() {
     m_handlers[Network::PacketType::PLAYER_DOWN] = std::bind(&PacketHandler::handlePlayerDown, this, std::placeholders::_1);
     m_handlers[Network::PacketType::OPEN_MENU] = std::bind(&PacketHandler::handleOpenMenu, this, std::placeholders::_1);
     m_handlers[Network::PacketType::IMPORTANT_PACKET_RECEIVED] = std::bind(&PacketHandler::handleImportantPacketReceived, this, std::placeholders::_1);
+    m_handlers[Network::PacketType::FRAME_ACK] = std::bind(&PacketHandler::handleFrameAck, this, std::placeholders::_1);
 }
 
 void PacketHandler::handlePacket(const Network::Packet &packet) {
@@ -77,13 +78,14 @@ void PacketHandler::handlePacket(const Network::Packet &packet) {
 void PacketHandler::handleImportantPacketReceived(const Network::Packet &packet)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+    auto client = m_server.findClient(packet.endpoint);
     std::lock_guard<std::mutex> server_guard(m_server.server_mutex);
     size_t delimiterPos = packet.rawData.find(';');
-    if (delimiterPos != std::string::npos)
+    if (client && delimiterPos != std::string::npos)
     {
         try {
             int frameId = std::stoi(packet.rawData.substr(delimiterPos + 1));
-            m_server.unacknowledgedPackets.erase(frameId);
+            m_server.unacknowledgedPackets.erase(std::make_pair(client->getMatchId(), frameId));
         } catch (const std::invalid_argument& e) {
             std::cerr << "[ERROR] Invalid argument in packet data: " << e.what() << std::endl;
         } catch (const std::out_of_range& e) {
@@ -92,6 +94,22 @@ void PacketHandler::handleImportantPacketReceived(const Network::Packet &packet)
     }
 }
 
+// The acknowledged frame becomes the baseline of the client's next position deltas.
+void PacketHandler::handleFrameAck(const Network::Packet &packet)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t delimiterPos = packet.rawData.find(';');
+    if (delimiterPos != std::string::npos)
+    {
+        try {
+            int frameId = std::stoi(packet.rawData.substr(delimiterPos + 1));
+            m_server.acknowledgeFrame(packet.endpoint, frameId);
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR] Invalid frame id in packet data: " << e.what() << std::endl;
+        }
+    }
+}
+
 void PacketHandler::handleNone(const Network::Packet &packet)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -102,33 +120,39 @@ void PacketHandler::reqConnect(const Network::Packet &packet)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     std::cout << "[PacketHandler] Handled CONNECTED packet." << std::endl;
-    auto endpoint = m_server.getRemoteEndpoint();
-    m_server.reqConnectData(endpoint);
+    auto endpoint = packet.endpoint;
+    // "<type>;<match id>", clients sending no id join match 0.
+    uint32_t matchId = 0;
+    size_t delimiterPos = packet.rawData.find(';');
+    if (delimiterPos != std::string::npos) {
+        try {
+            matchId = std::stoul(packet.rawData.substr(delimiterPos + 1));
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR] Invalid match id in packet data: " << e.what() << std::endl;
+        }
+    }
+    m_server.reqConnectData(endpoint, matchId);
 }
 
 void PacketHandler::handleDisconnected(const Network::Packet &packet)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     std::cout << "[PacketHandler] Handled DISCONNECTED packet." << std::endl;
-    auto endpoint = m_server.getRemoteEndpoint();
+    auto endpoint = packet.endpoint;
     m_server.disconnectData(endpoint);
 }
 
 void PacketHandler::handleGameStart(const Network::Packet &packet)
 {
-    int numPlayers;
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        std::cout << "[PacketHandler] Handled GAME_START packet." << std::endl;
-        m_server.m_running = true;
-        const auto& clients = m_server.getClients();
-        numPlayers = clients.size();
-        m_server.Broadcast(m_server.createPacket(Network::PacketType::GAME_START, ""));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::cout << "[PacketHandler] Handled GAME_START packet." << std::endl;
+    auto client = m_server.findClient(packet.endpoint);
+    if (!client) {
+        std::cerr << "[PacketHandler] Client endpoint not found in client list." << std::endl;
+        return;
     }
-    std::thread gameThread([this, numPlayers] {
-        m_game.run(numPlayers);
-    });
-    gameThread.detach();
+    m_matches.startMatch(client->getMatchId());
+    m_server.Broadcast(m_server.createPacket(Network::PacketType::GAME_START), client->getMatchId());
 }
 
 void PacketHandler::handlePlayerDead(const Network::Packet &packet)
@@ -229,32 +253,15 @@ void PacketHandler::handleOpenMenu(const Network::Packet &packet)
 
 void PacketHandler::handlePlayerAction(const Network::Packet &packet, int action)
 {
-    {
-        std::lock_guard<std::mutex> lock(m_server.clients_mutex_);
-        if (!m_server.m_running) {
-            std::cout << "[PacketHandler] game is not running, cannot move." << std::endl;
-            return;
-        }
-    }
-    const auto& clients = m_server.getClients();
-    const udp::endpoint& clientEndpoint = m_server.getRemoteEndpoint();
-
-    size_t playerId = -1;
-    bool found = false;
-    {
-        std::lock_guard<std::mutex> lock(m_server.clients_mutex_);
-
-        for (const auto& [id, client] : clients) {
-            if (client.getEndpoint() == clientEndpoint) {
-                playerId = id;
-                found = true;
-                break;
-            }
-        }
-    }
-    if (found) {
-        m_game.addPlayerAction(playerId, action);
-    } else {
+    auto client = m_server.findClient(packet.endpoint);
+    if (!client) {
         std::cerr << "[PacketHandler] Client endpoint not found in client list." << std::endl;
+        return;
+    }
+    auto match = m_matches.find(client->getMatchId());
+    if (!match || !match->running) {
+        std::cout << "[PacketHandler] game is not running, cannot move." << std::endl;
+        return;
     }
+    match->game->addPlayerAction(client->getId(), action);
 }
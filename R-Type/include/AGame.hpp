@@ -10,17 +10,22 @@
 
 #include "GeneralEntity.hpp"
 #include "EngineFrame.hpp"
+#include "GameClock.hpp"
 #include <map>
 
 class AGame {
     public:
         AGame() = default;
         virtual ~AGame() = default;
-        virtual void run(int numPlayers) = 0;
+        // Runs one fixed step and stores its frame; whoever hosts the game
+        // calls it each time getClock().tryStep() reports a step due.
+        virtual void step() = 0;
+        virtual GameClock& getClock() = 0;
         virtual void addPlayerAction(int playerId, int action) = 0;
         virtual std::map<int, GeneralEntity>& getEntities() = 0;
         virtual std::pair<float, float> getEntityPosition(int entityId) const = 0;
         virtual std::map<int, EngineFrame>& getEngineFrames() = 0;
+        virtual Registry& getRegistry() = 0;
 };
 
 #endif // AGAME_HPP
@@ -5,16 +5,28 @@
 ** EngineFrame
 */
 
-#include <iostream>
-#include <string>
+#include <algorithm>
+#include <vector>
+#include "WireProtocol.hpp"
 
 #ifndef ENGINEFRAME_HPP
 #define ENGINEFRAME_HPP
 
 class EngineFrame {
 public:
-    std::string frameInfos;
+    void add(Network::PacketType type, int32_t id = -1, float x = -1.0f, float y = -1.0f) {
+        records.push_back({type, id, x, y});
+    }
+
+    // Frames carrying an IMPORTANT_PACKET marker are resent until acknowledged.
+    bool isImportant() const {
+        return std::any_of(records.begin(), records.end(), [](const Network::EntityRecord& record) {
+            return record.type == Network::PacketType::IMPORTANT_PACKET;
+        });
+    }
+
+    std::vector<Network::EntityRecord> records;
     bool sent = false;
 };
 
-#endif // ENGINEFRAME_HPP
\ No newline at end of file
+#endif // ENGINEFRAME_HPP
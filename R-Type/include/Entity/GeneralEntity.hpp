@@ -3,6 +3,7 @@
 
 #include "Registry.hpp"
 #include <string>
+#include <cstdint>
 
 class GeneralEntity {
 public:
@@ -15,15 +16,22 @@ public:
         Ball
     };
 
+    // Collision layer of an entity type: one bit per type.
+    static std::uint32_t layerOf(EntityType type);
+
+    // Distance a bullet travels per tick, forward for the players' and backward for the enemies'.
+    static constexpr float bulletSpeed = 3.0f;
+
+    // Handle on an entity of a shared Registry: copies refer to the same
+    // entity, and the owner of the registry kills it explicitly.
     GeneralEntity(Registry& registry, EntityType type, float x, float y);
-    ~GeneralEntity();
 
     void move(float x, float y);
     Registry::Entity getEntity() const;
 
     const Registry& getRegistry() const;
     Registry& getRegistry();
-    void setRegistry(const Registry& newRegistry);
+    void setRegistry(Registry& newRegistry);
 
     EntityType getType() const;
     void setType(EntityType type);
@@ -34,7 +42,7 @@ public:
 private:
     void addComponents(EntityType type, float x, float y);
 
-    Registry registry;
+    Registry* registry;
     Registry::Entity entity;
     EntityType type;
     int numberOfLives = 1;
@@ -0,0 +1,42 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** GameClock
+*/
+
+#ifndef GAMECLOCK_HPP
+#define GAMECLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+// Fixed-step simulation clock, polled by a scheduler driving many of them.
+// tryStep() counts a step only when one is due, getNextStep() telling when to
+// come back. It keeps returning true while the game is late, so missed steps
+// are caught up; past maxCatchUp late steps the backlog is dropped instead of
+// making the game spiral. The tick counts the steps run, and getAlpha() tells
+// how far the current time is between the last step and the next one (for
+// interpolation).
+class GameClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit GameClock(Clock::duration step, int maxCatchUp = 5);
+
+    bool tryStep();
+    void reset();
+
+    std::uint64_t getTick() const;
+    Clock::duration getStep() const;
+    Clock::time_point getNextStep() const;
+    float getAlpha() const;
+
+private:
+    Clock::duration step;
+    int maxCatchUp;
+    Clock::time_point nextStep;
+    std::uint64_t tick = 0;
+};
+
+#endif // GAMECLOCK_HPP
@@ -5,6 +5,7 @@
 #include "Registry.hpp"
 #include "PlayerAction.hpp"
 #include "EngineFrame.hpp"
+#include "GameClock.hpp"
 #include "GeneralEntity.hpp"
 #include "ClientRegister.hpp"
 #include <SFML/Graphics.hpp>
@@ -20,10 +21,11 @@ namespace RType {
 
 class GameState : public AGame {
     public:
-        GameState(RType::Server* server);
+        GameState(RType::Server* server, uint32_t matchId);
         ~GameState();
 
-        void run(int numPlayers);
+        void step() override;
+        GameClock& getClock() override;
 
         // Implement player action management functions
         void addPlayerAction(int playerId, int actionId) override;
@@ -34,28 +36,31 @@ class GameState : public AGame {
         std::pair<float, float> getEntityPosition(int entityId) const override;
         std::map<int, GeneralEntity>& getEntities() override;
         std::map<int, EngineFrame>& getEngineFrames() override;
+        Registry& getRegistry() override;
 
         // Implement entity spawn and delete management functions
-        void spawnEntity(GeneralEntity::EntityType type, float x, float y, EngineFrame &frame);
+        int spawnEntity(GeneralEntity::EntityType type, float x, float y, EngineFrame &frame);
         void killEntity(int entityId, EngineFrame &frame);
+        void applyPendingKills(EngineFrame &frame);
+        void onEntityDestroyed(int entityId);
 
 
         //Implement generic Game Engine function to create a game from these
         void registerComponents();
         float randomFloat(float min, float max);
-        void moveBullets(EngineFrame &frame);
+        void moveProjectiles(EngineFrame &frame);
         void moveEnemies(EngineFrame &frame);
-        void moveEnemyBullets(EngineFrame &frame);
         void moveBoss(EngineFrame &frame);
-        void checkCollisions(GeneralEntity::EntityType typeA, GeneralEntity::EntityType typeB, float thresholdX, float thresholdY, EngineFrame &frame);
+        void resolveCollisions(EngineFrame &frame);
+        void applyHit(int idA, int idB, EngineFrame &frame);
         void CheckWinCondition(EngineFrame &frame);
 
         //GameState methods
         void spawnEnemiesRandomly(EngineFrame &frame);
         void spawnBossRandomly(EngineFrame &frame);
-        void initializeplayers(int numPlayers, EngineFrame &frame);
+        void initializeplayers(const std::map<uint32_t, ClientRegister>& clients, EngineFrame &frame);
         void handlePlayerMove(int playerId, int actionId);
-        void checkForDisconnectedPlayers(EngineFrame &frame);
+        void checkForDisconnectedPlayers(const std::map<uint32_t, ClientRegister>& clients, EngineFrame &frame);
         void removePlayerEntity(uint32_t disconnectedClientId, EngineFrame &frame);
         void handlePlayerShoot(int PlayerId, EngineFrame &frame);
         bool areEnemiesCleared() const;
@@ -68,21 +73,22 @@ class GameState : public AGame {
 
     private:
     //old AGame variables
-    int id_to_set = 0;
     std::vector<PlayerAction> playerActions;
     std::map<int, GeneralEntity> entities;
     std::map<int, EngineFrame> engineFrames;
+    std::vector<int> pendingKills;
     Registry registry;
     RType::Server* m_server;
+    uint32_t matchId;
+    int frameId = 0;
     std::mutex playerActionsMutex;
 
     //GameState Variables
-    std::map<uint32_t, ClientRegister> previousClients;
+    // Player entity of each client of the match, by server client id.
     std::unordered_map<uint32_t, uint32_t> clientToEntity;
     std::mt19937 rng;
     std::chrono::steady_clock::time_point lastSpawnTime;
-    sf::Clock frameClock;
-    const sf::Time frameDuration = sf::milliseconds(10);
+    GameClock gameClock{std::chrono::milliseconds(10)};
     int playerSpawned = 0;
     int currentWave = 0;
     int currentBoss = 0;
@@ -90,6 +96,11 @@ class GameState : public AGame {
     int numberOfWaves = 1;
     int maxEnemyBullets = 5;
     int numberOfBoss = 1;
+    // Movement patterns, per match: matches step concurrently.
+    int enemyDirection = 0;
+    float enemyDistanceMoved = 0.0f;
+    int bossDirection = 0;
+    float bossDistanceMoved = 0.0f;
 };
 
 #endif // GAME_STATE_HPP
\ No newline at end of file
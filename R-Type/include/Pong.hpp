@@ -12,13 +12,16 @@
 #include "Registry.hpp"
 #include "PlayerAction.hpp"
 #include "EngineFrame.hpp"
+#include "GameClock.hpp"
 #include "GeneralEntity.hpp"
+#include "ClientRegister.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include <mutex>
 #include <random>
 #include <memory>
 #include <chrono>
+#include <unordered_map>
 
 namespace RType {
     class Server;
@@ -26,10 +29,11 @@ namespace RType {
 
 class Pong : public AGame {
     public:
-        Pong(RType::Server* server);
+        Pong(RType::Server* server, uint32_t matchId);
         ~Pong();
 
-        void run(int numPlayers);
+        void step() override;
+        GameClock& getClock() override;
 
         // Implement player action management functions
         void addPlayerAction(int playerId, int actionId) override;
@@ -40,9 +44,10 @@ class Pong : public AGame {
         std::pair<float, float> getEntityPosition(int entityId) const override;
         std::map<int, GeneralEntity>& getEntities() override;
         std::map<int, EngineFrame>& getEngineFrames() override;
+        Registry& getRegistry() override;
 
         // Implement entity spawn and delete management functions
-        void spawnEntity(GeneralEntity::EntityType type, float x, float y, EngineFrame &frame);
+        int spawnEntity(GeneralEntity::EntityType type, float x, float y, EngineFrame &frame);
         void killEntity(int entityId, EngineFrame &frame);
 
 
@@ -59,7 +64,7 @@ class Pong : public AGame {
         //GameState methods
         void spawnBallRandomly(EngineFrame &frame);
         void spawnBossRandomly(EngineFrame &frame);
-        void initializeplayers(int numPlayers, EngineFrame &frame);
+        void initializeplayers(const std::map<uint32_t, ClientRegister>& clients, EngineFrame &frame);
         void handlePlayerMove(int playerId, int actionId);
         bool areEnemiesCleared() const;
         bool areBossCleared() const;
@@ -71,19 +76,21 @@ class Pong : public AGame {
 
     private:
     //old AGame variables
-    int id_to_set = 0;
     std::vector<PlayerAction> playerActions;
     std::map<int, GeneralEntity> entities;
     std::map<int, EngineFrame> engineFrames;
     Registry registry;
     RType::Server* m_server;
+    uint32_t matchId;
+    int frameId = 0;
     std::mutex playerActionsMutex;
 
     //GameState Variables
     std::mt19937 rng;
     std::chrono::steady_clock::time_point lastSpawnTime;
-    sf::Clock frameClock;
-    const sf::Time frameDuration = sf::milliseconds(10);
+    GameClock gameClock{std::chrono::milliseconds(10)};
+    // Player entity of each client of the match, by server client id.
+    std::unordered_map<uint32_t, int> clientToEntity;
     bool gameOver = false;
     int playerSpawned = 0;
     int maxPlayers = 2;
@@ -92,6 +99,6 @@ class Pong : public AGame {
     int maxBalls = 1;
 };
 
-extern "C" AGame* create_game(void* server);
+extern "C" AGame* create_game(void* server, uint32_t matchId);
 
 #endif //PONG_HPP
@@ -1,65 +1,69 @@
 #include "GeneralEntity.hpp"
 #include "Position.hpp"
 #include "Velocity.hpp"
-#include "Drawable.hpp"
+#include "Collider.hpp"
 #include "Collidable.hpp"
 #include "Controllable.hpp"
 #include "Projectile.hpp"
 #include <iostream>
 
-GeneralEntity::GeneralEntity(Registry& registry, EntityType type, float x, float y) : registry(registry), type(type) {
-    entity = this->registry.spawn_entity();
+GeneralEntity::GeneralEntity(Registry& registry, EntityType type, float x, float y) : registry(&registry), type(type) {
+    entity = this->registry->spawn_entity();
     addComponents(type, x, y);
 }
 
-GeneralEntity::~GeneralEntity() {
-    if (registry.entity_exists(entity))
-        registry.kill_entity(entity);
+std::uint32_t GeneralEntity::layerOf(EntityType type) {
+    return 1u << static_cast<std::uint32_t>(type);
 }
 
+// Collider half-extents are the hit distances of the game rules: a bullet
+// (2.5) hits an enemy (17.5 x 37.5) when |dx| < 20 and |dy| < 40.
 void GeneralEntity::addComponents(EntityType type, float x, float y) {
-    this->registry.add_component<Position>(entity, {x, y});
+    this->registry->add_component<Position>(entity, {x, y});
 
     switch (type) {
         case EntityType::Player:
-            this->registry.add_component<Velocity>(entity, {0.0f, 0.0f});
-            this->registry.add_component<Drawable>(entity, {sf::RectangleShape(sf::Vector2f(50.0f, 50.0f))});
-            this->registry.add_component<Controllable>(entity, {});
-            this->registry.add_component<Collidable>(entity, {true});
+            this->registry->add_component<Velocity>(entity, {0.0f, 0.0f});
+            this->registry->add_component<Collider>(entity, {27.5f, 47.5f, layerOf(type), layerOf(EntityType::EnemyBullet)});
+            this->registry->add_component<Controllable>(entity, {});
+            this->registry->add_component<Collidable>(entity, {true});
             break;
         case EntityType::Enemy:
-            this->registry.add_component<Drawable>(entity, {sf::RectangleShape(sf::Vector2f(50.0f, 50.0f))});
-            this->registry.add_component<Collidable>(entity, {true});
+            this->registry->add_component<Collider>(entity, {17.5f, 37.5f, layerOf(type), layerOf(EntityType::Bullet)});
+            this->registry->add_component<Collidable>(entity, {true});
             break;
         case EntityType::Bullet:
-            this->registry.add_component<Projectile>(entity, {1.0f});
-            this->registry.add_component<Drawable>(entity, {sf::RectangleShape(sf::Vector2f(5.0f, 5.0f))});
-            this->registry.add_component<Collidable>(entity, {true});
+            this->registry->add_component<Velocity>(entity, {bulletSpeed, 0.0f});
+            this->registry->add_component<Projectile>(entity, {1.0f});
+            this->registry->add_component<Collider>(entity, {2.5f, 2.5f, layerOf(type), layerOf(EntityType::Enemy) | layerOf(EntityType::Boss)});
+            this->registry->add_component<Collidable>(entity, {true});
             break;
         case EntityType::Ball:
-            this->registry.add_component<Projectile>(entity, {1.0f});
-            this->registry.add_component<Drawable>(entity, {sf::RectangleShape(sf::Vector2f(5.0f, 5.0f))});
-            this->registry.add_component<Collidable>(entity, {true});
+            this->registry->add_component<Projectile>(entity, {1.0f});
+            this->registry->add_component<Collider>(entity, {2.5f, 2.5f, layerOf(type), layerOf(EntityType::Player)});
+            this->registry->add_component<Collidable>(entity, {true});
             break;
         case EntityType::Boss:
-            this->registry.add_component<Velocity>(entity, {0.0f, 0.0f});
-            this->registry.add_component<Drawable>(entity, {sf::RectangleShape(sf::Vector2f(100.0f, 100.0f))});
-            this->registry.add_component<Collidable>(entity, {true});
+            this->registry->add_component<Velocity>(entity, {0.0f, 0.0f});
+            this->registry->add_component<Collider>(entity, {47.5f, 47.5f, layerOf(type), layerOf(EntityType::Bullet)});
+            this->registry->add_component<Collidable>(entity, {true});
             this->numberOfLives = 3;
             break;
         case EntityType::EnemyBullet:
-            this->registry.add_component<Projectile>(entity, {1.0f});
-            this->registry.add_component<Drawable>(entity, {sf::RectangleShape(sf::Vector2f(5.0f, 5.0f))});
-            this->registry.add_component<Collidable>(entity, {true});
+            this->registry->add_component<Velocity>(entity, {-bulletSpeed, 0.0f});
+            this->registry->add_component<Projectile>(entity, {1.0f});
+            this->registry->add_component<Collider>(entity, {2.5f, 2.5f, layerOf(type), layerOf(EntityType::Player)});
+            this->registry->add_component<Collidable>(entity, {true});
             break;
     }
 }
 
 void GeneralEntity::move(float x, float y) {
-    if (registry.has_component<Position>(entity)) {
-        auto& pos = registry.get_components<Position>()[entity];
-        pos->x += x;
-        pos->y += y;
+    if (registry->has_component<Position>(entity)) {
+        registry->get_components<Position>().patch(Registry::entity_index(entity), [x, y](Position& pos) {
+            pos.x += x;
+            pos.y += y;
+        });
     } else {
         std::cerr << "Error: Entity does not have a Position component." << std::endl;
     }
@@ -70,15 +74,15 @@ Registry::Entity GeneralEntity::getEntity() const {
 }
 
 const Registry& GeneralEntity::getRegistry() const {
-    return registry;
+    return *registry;
 }
 
 Registry& GeneralEntity::getRegistry() {
-    return registry;
+    return *registry;
 }
 
-void GeneralEntity::setRegistry(const Registry& newRegistry) {
-    registry = newRegistry;
+void GeneralEntity::setRegistry(Registry& newRegistry) {
+    registry = &newRegistry;
 }
 
 GeneralEntity::EntityType GeneralEntity::getType() const {
@@ -0,0 +1,47 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** GameClock
+*/
+
+#include "GameClock.hpp"
+#include <algorithm>
+
+GameClock::GameClock(Clock::duration step, int maxCatchUp)
+    : step(step), maxCatchUp(maxCatchUp), nextStep(Clock::now()) {}
+
+bool GameClock::tryStep() {
+    Clock::time_point now = Clock::now();
+    if (now < nextStep) {
+        return false;
+    }
+    if (now - nextStep >= step * maxCatchUp) {
+        nextStep = now;
+    }
+    nextStep += step;
+    ++tick;
+    return true;
+}
+
+void GameClock::reset() {
+    nextStep = Clock::now();
+    tick = 0;
+}
+
+std::uint64_t GameClock::getTick() const {
+    return tick;
+}
+
+GameClock::Clock::duration GameClock::getStep() const {
+    return step;
+}
+
+GameClock::Clock::time_point GameClock::getNextStep() const {
+    return nextStep;
+}
+
+float GameClock::getAlpha() const {
+    std::chrono::duration<float> sinceStep = Clock::now() - (nextStep - step);
+    return std::clamp(sinceStep / std::chrono::duration<float>(step), 0.0f, 1.0f);
+}
@@ -10,13 +10,13 @@
 #include "AGame.hpp"
 #include "Velocity.hpp"
 #include "CollisionSystem.hpp"
+#include "ProjectileSystem.hpp"
 #include <algorithm>
 #include <iostream>
 #include <random>
 #include <thread>
 
-GameState::GameState(RType::Server* server) : m_server(server) {
-    std::srand(static_cast<unsigned int>(std::time(0)));
+GameState::GameState(RType::Server* server, uint32_t matchId) : m_server(server), matchId(matchId), rng(std::random_device{}()) {
     registerComponents();
 }
 
@@ -34,14 +34,32 @@ std::map<int, EngineFrame>& GameState::getEngineFrames() {
     return engineFrames;
 }
 
+Registry& GameState::getRegistry() {
+    return registry;
+}
+
+GameClock& GameState::getClock() {
+    return gameClock;
+}
+
 void GameState::registerComponents()
 {
     registry.register_component<Position>();
     registry.register_component<Velocity>();
-    registry.register_component<Drawable>();
+    registry.register_component<Collider>();
     registry.register_component<Controllable>();
     registry.register_component<Collidable>();
     registry.register_component<Projectile>();
+    registry.group<Position, Velocity, Projectile>();
+    // Kills made by systems leave the entity list too.
+    registry.on_destroy<Position>().connect([this](Registry&, Registry::Entity entity) {
+        onEntityDestroyed(static_cast<int>(Registry::entity_index(entity)));
+    });
+}
+
+void GameState::onEntityDestroyed(int entityId)
+{
+    entities.erase(entityId);
 }
 
 void GameState::addPlayerAction(int playerId, int actionId) {
@@ -84,159 +102,119 @@ std::pair<float, float> GameState::getEntityPosition(int entityId) const
         throw std::out_of_range("Invalid entity ID");
     }
 
-    const auto& positionComponent = it->second.getRegistry().get_components<Position>()[it->second.getEntity()];
-    return {positionComponent->x, positionComponent->y};
+    const auto& positionComponent = registry.get_components<Position>()[Registry::entity_index(it->second.getEntity())];
+    return {positionComponent.x, positionComponent.y};
 }
 
-void GameState::spawnEntity(GeneralEntity::EntityType type, float x, float y, EngineFrame &frame) {
-    int entityId = id_to_set;
+int GameState::spawnEntity(GeneralEntity::EntityType type, float x, float y, EngineFrame &frame) {
     if (type == GeneralEntity::EntityType::Bullet) {
         x += 50.0f;
         y += 25.0f;
     }
 
-    entities.emplace(entityId, GeneralEntity(registry, type, x, y));
-
-    std::string data = std::to_string(entityId) + ";" + std::to_string(x) + ";" + std::to_string(y) + "/";
-
-    Network::PacketType packetType;
-    switch (type) {
-    case GeneralEntity::EntityType::Player:
-        packetType = Network::PacketType::CREATE_PLAYER;
-        clientToEntity[playerSpawned] = entityId;
-        break;
-    case GeneralEntity::EntityType::Enemy:
-        packetType = Network::PacketType::CREATE_ENEMY;
-        break;
-    case GeneralEntity::EntityType::Boss:
-        packetType = Network::PacketType::CREATE_BOSS;
-        break;
-    case GeneralEntity::EntityType::Bullet:
-        packetType = Network::PacketType::CREATE_BULLET;
-        break;
-    case GeneralEntity::EntityType::EnemyBullet:
-        packetType = Network::PacketType::CREATE_ENEMY_BULLET;
-        break;
-    default:
-        std::cerr << "Error: Unsupported entity type for spawning." << std::endl;
-        return;
-    }
+    // Clients know entities by their registry slot, which is recycled lowest first.
+    GeneralEntity entity(registry, type, x, y);
+    int entityId = static_cast<int>(Registry::entity_index(entity.getEntity()));
+    entities.emplace(entityId, entity);
 
-    frame.frameInfos += m_server->createPacket(packetType, data);
-    frame.frameInfos += m_server->createPacket(Network::PacketType::IMPORTANT_PACKET, "-1;-1;-1/");
-    id_to_set++;
+    // Clients learn about the entity from the entity block the server
+    // replicates to each of them.
+    return entityId;
 }
 
+// Kills are deferred to applyPendingKills() so passes can iterate entities directly.
 void GameState::killEntity(int entityId, EngineFrame &frame)
 {
     auto it = entities.find(entityId);
-    if (it != entities.end()) {
-        it->second.getRegistry().kill_entity(it->second.getEntity());
-        entities.erase(it);
-        std::string data = std::to_string(entityId) + ";-1;-1/";
-        frame.frameInfos += m_server->createPacket(Network::PacketType::DELETE, data);
-        frame.frameInfos += m_server->createPacket(Network::PacketType::IMPORTANT_PACKET, "-1;-1;-1/");
+    if (it != entities.end() && std::find(pendingKills.begin(), pendingKills.end(), entityId) == pendingKills.end()) {
+        registry.commands().kill(it->second.getEntity());
+        pendingKills.push_back(entityId);
     }
 }
 
-void GameState::moveBullets(EngineFrame &frame) {
-    const float maxX = 1500;
-    const float bulletSpeed = 3.0f;
-
-    std::map <int, GeneralEntity> temp_entities = entities;
-    for (auto& [id, entity] : temp_entities) {
-        if (entity.getType() == GeneralEntity::EntityType::Bullet) {
-            auto [x, y] = getEntityPosition(id);
-            float newX = x + bulletSpeed;
-            if (newX > maxX) {
-                killEntity(id, frame);
-            } else {
-                entities.find(id)->second.move(bulletSpeed, 0.0f);
-            }
-        }
-    }
+void GameState::applyPendingKills(EngineFrame &frame)
+{
+    registry.flush_commands();
+    pendingKills.clear();
 }
 
-void GameState::moveEnemyBullets(EngineFrame &frame) {
+// Bullets move by their Velocity through the Position/Velocity/Projectile group, then leave past the screen edges.
+void GameState::moveProjectiles(EngineFrame &frame) {
     const float minX = 0.0f;
-    const float bulletSpeed = -3.0f;
-
-    std::map<int, GeneralEntity> temp_entities = entities;
-    for (auto& [id, entity] : temp_entities) {
-        if (entity.getType() == GeneralEntity::EntityType::EnemyBullet) {
-            auto [x, y] = getEntityPosition(id);
-            float newX = x + bulletSpeed;
-            if (newX < minX) {
-                killEntity(id, frame);
-            } else {
-                entities.find(id)->second.move(bulletSpeed, 0.0f);
-            }
-        }
+    const float maxX = 1500;
+
+    move_projectiles(registry, registry.get_components<Position>(), registry.get_components<Velocity>(), registry.get_components<Projectile>());
+    for (auto& [id, entity] : entities) {
+        GeneralEntity::EntityType type = entity.getType();
+        if (type != GeneralEntity::EntityType::Bullet && type != GeneralEntity::EntityType::EnemyBullet)
+            continue;
+        float x = getEntityPosition(id).first;
+        if ((type == GeneralEntity::EntityType::Bullet && x > maxX) || (type == GeneralEntity::EntityType::EnemyBullet && x < minX))
+            killEntity(id, frame);
     }
 }
 
-void GameState::checkCollisions(GeneralEntity::EntityType typeA, GeneralEntity::EntityType typeB, float thresholdX, float thresholdY, EngineFrame &frame) {
-    auto tempEntities = entities; // Copy to avoid iterator invalidation
-
-    for (auto& [idA, entityA] : tempEntities) {
-        if (entityA.getType() != typeA) continue;
-        auto [posXA, posYA] = getEntityPosition(idA);
-
-        for (auto& [idB, entityB] : tempEntities) {
-            if (entityB.getType() != typeB || idA == idB) continue;
-
-            auto [posXB, posYB] = getEntityPosition(idB);
-
-            if (std::abs(posXA - posXB) < thresholdX && std::abs(posYA - posYB) < thresholdY) {
-                if (entityA.getNumberOfLives() == 1) {
-                    killEntity(idA, frame);
-                } else {
-                    entities.find(idA)->second.setNumberOfLives(entityA.getNumberOfLives() - 1);
-                }
-                if (entityB.getNumberOfLives() == 1) {
-                    killEntity(idB, frame);
-                } else {
-                    entities.find(idB)->second.setNumberOfLives(entityB.getNumberOfLives() - 1);
-                }
-                return;
-            }
-        }
+// One broad-phase pass per tick: every hit of the tick is applied, not only the first one per rule.
+void GameState::resolveCollisions(EngineFrame &frame) {
+    collision_pairs hits = find_collisions(registry.get_components<Position>(), registry.get_components<Collider>(), registry.get_components<Collidable>());
+    // Entity ids are registry slots; applyHit skips slots that are no game entity.
+    auto hit = [this, &frame](std::size_t a, std::size_t b) {
+        applyHit(static_cast<int>(a), static_cast<int>(b), frame);
+    };
+    using Type = GeneralEntity::EntityType;
+    hits.each(GeneralEntity::layerOf(Type::Bullet), GeneralEntity::layerOf(Type::Enemy), hit);
+    hits.each(GeneralEntity::layerOf(Type::EnemyBullet), GeneralEntity::layerOf(Type::Player), hit);
+    hits.each(GeneralEntity::layerOf(Type::Bullet), GeneralEntity::layerOf(Type::Boss), hit);
+}
+
+void GameState::applyHit(int idA, int idB, EngineFrame &frame) {
+    auto isDying = [this](int id) {
+        return std::find(pendingKills.begin(), pendingKills.end(), id) != pendingKills.end();
+    };
+    auto itA = entities.find(idA);
+    auto itB = entities.find(idB);
+    if (itA == entities.end() || itB == entities.end() || isDying(idA) || isDying(idB)) {
+        return;
     }
+    auto damage = [this, &frame](int id, GeneralEntity& entity) {
+        if (entity.getNumberOfLives() == 1) {
+            killEntity(id, frame);
+        } else {
+            entity.setNumberOfLives(entity.getNumberOfLives() - 1);
+        }
+    };
+    damage(idA, itA->second);
+    damage(idB, itB->second);
 }
 
 void GameState::moveEnemies(EngineFrame &frame) {
-    static int direction = 0;
-    static float distanceMoved = 0.0f;
     const float moveDistance = 2.0f;
     const float switchThreshold = 25.0f;
 
-    static sf::Clock moveClock;
-    const sf::Time moveInterval = sf::milliseconds(100);
+    const std::uint64_t moveIntervalTicks = 10;
 
-    if (moveClock.getElapsedTime() >= moveInterval)
+    if (gameClock.getTick() % moveIntervalTicks == 0)
     {
-        moveClock.restart();
-        std::map<int, GeneralEntity> temp_entities = entities;
-        for (auto& [id, entity] : temp_entities) {
+        for (auto& [id, entity] : entities) {
             if (entity.getType() == GeneralEntity::EntityType::Enemy) {
                 float x = 0.0f, y = 0.0f;
 
-                switch (direction) {
+                switch (enemyDirection) {
                 case 0: y = -moveDistance; break; // Up
                 case 1: x = -moveDistance; break; // Left
                 case 2: y = moveDistance; break;  // Down
                 case 3: x = moveDistance; break;  // Right
                 }
 
-                entities.find(id)->second.move(x, y);
-                distanceMoved += moveDistance;
+                entity.move(x, y);
+                enemyDistanceMoved += moveDistance;
 
-                if (distanceMoved >= switchThreshold) {
-                    direction = (direction + 1) % 4;
-                    distanceMoved = 0.0f;
+                if (enemyDistanceMoved >= switchThreshold) {
+                    enemyDirection = (enemyDirection + 1) % 4;
+                    enemyDistanceMoved = 0.0f;
                 }
 
-                if (countEnemyBullets() < maxEnemyBullets && rand() % 100 < 1.0) {
+                if (countEnemyBullets() < maxEnemyBullets && rng() % 100 < 1.0) {
                     auto[x, y] = getEntityPosition(id);
                     spawnEntity(GeneralEntity::EntityType::EnemyBullet, x - 50.0f, y - 25.0f, frame);
                 }
@@ -246,39 +224,34 @@ void GameState::moveEnemies(EngineFrame &frame) {
 }
 
 void GameState::moveBoss(EngineFrame &frame) {
-    static int direction = 0;
-    static float distanceMoved = 0.0f;
     const float moveDistance = 2.0f;
     const float switchThreshold = 50.0f;
 
-    static sf::Clock moveClock;
-    const sf::Time moveInterval = sf::milliseconds(100);
+    const std::uint64_t moveIntervalTicks = 10;
 
-    if (moveClock.getElapsedTime() >= moveInterval) {
-        moveClock.restart();
+    if (gameClock.getTick() % moveIntervalTicks == 0) {
 
-        std::map<int, GeneralEntity> temp_entities = entities;
-        for (auto& [id, entity] : temp_entities) {
+        for (auto& [id, entity] : entities) {
             if (entity.getType() == GeneralEntity::EntityType::Boss) {
                 float x = 0.0f, y = 0.0f;
 
-                direction = rand() % 4;
-                switch (direction) {
+                bossDirection = rng() % 4;
+                switch (bossDirection) {
                 case 0: y = -moveDistance; break; // Up
                 case 1: x = -moveDistance; break; // Left
                 case 2: y = moveDistance; break;  // Down
                 case 3: x = moveDistance; break;  // Right
                 }
 
-                entities.find(id)->second.move(x, y);
-                distanceMoved += moveDistance;
+                entity.move(x, y);
+                bossDistanceMoved += moveDistance;
 
-                if (distanceMoved >= switchThreshold) {
-                    direction = rand() % 4;
-                    distanceMoved = 0.0f;
+                if (bossDistanceMoved >= switchThreshold) {
+                    bossDirection = rng() % 4;
+                    bossDistanceMoved = 0.0f;
                 }
 
-                if (countEnemyBullets() < (maxEnemyBullets + 5) && rand() % 100 < 3.0) {
+                if (countEnemyBullets() < (maxEnemyBullets + 5) && rng() % 100 < 3.0) {
                     auto [x, y] = getEntityPosition(id);
                     spawnEntity(GeneralEntity::EntityType::EnemyBullet, x - 50.0f, y - 25.0f, frame);
                 }
@@ -287,32 +260,30 @@ void GameState::moveBoss(EngineFrame &frame) {
     }
 }
 
-void GameState::initializeplayers(int numPlayers, EngineFrame &frame) {
-    for (int i = playerSpawned; i < numPlayers; ++i) {
-        frame.frameInfos += m_server->createPacket(Network::PacketType::CREATE_BACKGROUND, "-100;0;0/");
-        spawnEntity(GeneralEntity::EntityType::Player, 100.0f * (i + 1.0f), 100.0f, frame);
+// Clients are known by their server id, unique across matches, not by their
+// rank in this one.
+void GameState::initializeplayers(const std::map<uint32_t, ClientRegister>& clients, EngineFrame &frame) {
+    for (const auto& [clientId, client] : clients) {
+        if (clientToEntity.count(clientId))
+            continue;
+        frame.add(Network::PacketType::CREATE_BACKGROUND, -100, 0.0f, 0.0f);
+        frame.add(Network::PacketType::IMPORTANT_PACKET);
+        clientToEntity[clientId] = spawnEntity(GeneralEntity::EntityType::Player, 100.0f * (playerSpawned + 1.0f), 100.0f, frame);
         playerSpawned++;
     }
 }
 
 void GameState::CheckWinCondition(EngineFrame &frame) {
     if (currentWave == numberOfWaves && currentBoss == numberOfBoss && areEnemiesCleared() && areBossCleared()) {
-        frame.frameInfos += m_server->createPacket(Network::PacketType::WIN, "-1;-1;-1/");
+        frame.add(Network::PacketType::WIN);
     }
 }
 
-void GameState::checkForDisconnectedPlayers(EngineFrame &frame) {
-    std::lock_guard<std::mutex> lock(m_server->clients_mutex_);
-    if (m_server->getClients().size() >= previousClients.size()) {
-        previousClients = m_server->getClients();
-        return;
-    }
-
-    std::map<uint32_t, ClientRegister> currentClients = m_server->getClients();
+void GameState::checkForDisconnectedPlayers(const std::map<uint32_t, ClientRegister>& clients, EngineFrame &frame) {
     std::vector<uint32_t> disconnectedClients;
 
-    for (const auto& [clientId, client] : previousClients) {
-        if (currentClients.find(clientId) == currentClients.end()) {
+    for (const auto& [clientId, entityId] : clientToEntity) {
+        if (clients.find(clientId) == clients.end()) {
             disconnectedClients.push_back(clientId);
         }
     }
@@ -320,9 +291,6 @@ void GameState::checkForDisconnectedPlayers(EngineFrame &frame) {
     for (uint32_t clientId : disconnectedClients) {
         removePlayerEntity(clientId, frame);
     }
-
-    disconnectedClients.clear();
-    previousClients = currentClients;
 }
 
 void GameState::removePlayerEntity(uint32_t disconnectedClientId, EngineFrame &frame) {
@@ -337,10 +305,13 @@ void GameState::removePlayerEntity(uint32_t disconnectedClientId, EngineFrame &f
 }
 
 void GameState::update(EngineFrame &frame) {
+    registry.advance_tick();
     registry.run_systems();
-    initializeplayers(m_server->getClients().size(), frame);
+    ClientList clients = m_server->getMatchClients(matchId);
+    initializeplayers(clients, frame);
     processPlayerActions(frame);
-    checkForDisconnectedPlayers(frame);
+    checkForDisconnectedPlayers(clients, frame);
+    applyPendingKills(frame);
 
     if (areEnemiesCleared()) {
         if (currentWave < numberOfWaves) {
@@ -349,30 +320,20 @@ void GameState::update(EngineFrame &frame) {
             spawnBossRandomly(frame);
         }
     }
-    checkCollisions(GeneralEntity::EntityType::Bullet, GeneralEntity::EntityType::Enemy, 20.0f, 40.0f, frame);
-    moveBullets(frame);
+    resolveCollisions(frame);
+    applyPendingKills(frame);
+    moveProjectiles(frame);
+    applyPendingKills(frame);
     moveEnemies(frame);
-    checkCollisions(GeneralEntity::EntityType::EnemyBullet, GeneralEntity::EntityType::Player, 30.0f, 50.0f, frame);
-    moveEnemyBullets(frame);
-    checkCollisions(GeneralEntity::EntityType::Bullet, GeneralEntity::EntityType::Boss, 50.0f, 50.0f, frame);
+    applyPendingKills(frame);
     moveBoss(frame);
     CheckWinCondition(frame);
 }
 
-void GameState::run(int numPlayers) {
-    int frameId = 0;
-    int last_frame_sent = 0;
-
-    while (true) {
-        if (frameClock.getElapsedTime() >= frameDuration) {
-            frameClock.restart();
-            EngineFrame new_frame;
-            m_server->server_mutex.lock();
-            update(new_frame);
-            engineFrames.emplace(frameId++, new_frame);
-            m_server->server_mutex.unlock();
-        }
-    }
+void GameState::step() {
+    EngineFrame new_frame;
+    update(new_frame);
+    engineFrames.emplace(frameId++, new_frame);
 }
 
 void GameState::handlePlayerShoot(int PlayerId, EngineFrame &frame) {
@@ -442,7 +403,7 @@ bool GameState::areBossCleared() const {
 }
 
 float GameState::randomFloat(float min, float max) {
-    return min + static_cast<float>(std::rand()) / (RAND_MAX / (max - min));
+    return std::uniform_real_distribution<float>(min, max)(rng);
 }
 
 void GameState::spawnEnemiesRandomly(EngineFrame &frame) {
@@ -472,6 +433,6 @@ size_t GameState::getEntityCount() const {
     return entities.size();
 }
 
-extern "C" AGame* create_game(void* server) {
-    return new GameState(static_cast<RType::Server*>(server));
+extern "C" AGame* create_game(void* server, uint32_t matchId) {
+    return new GameState(static_cast<RType::Server*>(server), matchId);
 }
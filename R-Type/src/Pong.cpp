@@ -16,8 +16,7 @@
 #include <random>
 #include <thread>
 
-Pong::Pong(RType::Server* server) : m_server(server) {
-    std::srand(static_cast<unsigned int>(std::time(0)));
+Pong::Pong(RType::Server* server, uint32_t matchId) : m_server(server), matchId(matchId), rng(std::random_device{}()) {
     registerComponents();
 }
 
@@ -35,11 +34,19 @@ std::map<int, EngineFrame>& Pong::getEngineFrames() {
     return engineFrames;
 }
 
+Registry& Pong::getRegistry() {
+    return registry;
+}
+
+GameClock& Pong::getClock() {
+    return gameClock;
+}
+
 void Pong::registerComponents()
 {
     registry.register_component<Position>();
     registry.register_component<Velocity>();
-    registry.register_component<Drawable>();
+    registry.register_component<Collider>();
     registry.register_component<Controllable>();
     registry.register_component<Collidable>();
     registry.register_component<Projectile>();
@@ -82,48 +89,31 @@ std::pair<float, float> Pong::getEntityPosition(int entityId) const
         throw std::out_of_range("Invalid entity ID");
     }
 
-    const auto& positionComponent = it->second.getRegistry().get_components<Position>()[it->second.getEntity()];
-    return {positionComponent->x, positionComponent->y};
+    const auto& positionComponent = registry.get_components<Position>()[Registry::entity_index(it->second.getEntity())];
+    return {positionComponent.x, positionComponent.y};
 }
 
-void Pong::spawnEntity(GeneralEntity::EntityType type, float x, float y, EngineFrame &frame) {
-    int entityId = id_to_set;
+int Pong::spawnEntity(GeneralEntity::EntityType type, float x, float y, EngineFrame &frame) {
     if (type == GeneralEntity::EntityType::Bullet) {
         x += 50.0f;
         y += 25.0f;
     }
 
-    entities.emplace(entityId, GeneralEntity(registry, type, x, y));
-
-    std::string data = std::to_string(entityId) + ";" + std::to_string(x) + ";" + std::to_string(y) + "/";
-
-    Network::PacketType packetType;
-    switch (type) {
-    case GeneralEntity::EntityType::Player:
-        packetType = Network::PacketType::CREATE_PLAYER;
-        break;
-    case GeneralEntity::EntityType::Ball:
-        packetType = Network::PacketType::CREATE_BALL;
-        break;
-    default:
-        std::cerr << "Error: Unsupported entity type for spawning." << std::endl;
-        return;
-    }
-
-    frame.frameInfos += m_server->createPacket(packetType, data);
-    frame.frameInfos += m_server->createPacket(Network::PacketType::IMPORTANT_PACKET, "-1;-1;-1/");
-    id_to_set++;
+    // Clients know entities by their registry slot, which is recycled lowest first.
+    GeneralEntity entity(registry, type, x, y);
+    int entityId = static_cast<int>(Registry::entity_index(entity.getEntity()));
+    // Clients learn about the entity from the entity block the server
+    // replicates to each of them.
+    entities.emplace(entityId, entity);
+    return entityId;
 }
 
 void Pong::killEntity(int entityId, EngineFrame &frame)
 {
     auto it = entities.find(entityId);
     if (it != entities.end()) {
-        it->second.getRegistry().kill_entity(it->second.getEntity());
+        registry.kill_entity(it->second.getEntity());
         entities.erase(it);
-        std::string data = std::to_string(entityId) + ";-1;-1/";
-        frame.frameInfos += m_server->createPacket(Network::PacketType::DELETE, data);
-        frame.frameInfos += m_server->createPacket(Network::PacketType::IMPORTANT_PACKET, "-1;-1;-1/");
     }
 }
 
@@ -131,10 +121,9 @@ void Pong::moveBall(EngineFrame &frame) {
     const float maxY = 720.0f;
     const float minY = 0.0f;
     const float ballSpeedX = (lastPlayerHit == 1) ? 2.0f : -2.0f;
-    float deltaY = ((std::rand() % 2001) / 1000.0f) - 1.0f;
+    float deltaY = randomFloat(-1.0f, 1.0f);
 
-    std::map<int, GeneralEntity> temp_entities = entities;
-    for (auto& [id, entity] : temp_entities) {
+    for (auto& [id, entity] : entities) {
         if (entity.getType() == GeneralEntity::EntityType::Ball) {
             auto [x, y] = getEntityPosition(id);
             float newX = x + ballSpeedX;
@@ -149,25 +138,23 @@ void Pong::moveBall(EngineFrame &frame) {
             if (newX < -50 || newX > 1330)
                 gameOver = true;
 
-            entities.find(id)->second.move(ballSpeedX, deltaY);
+            entity.move(ballSpeedX, deltaY);
         }
     }
 }
 
 void Pong::checkCollisions(GeneralEntity::EntityType typeA, GeneralEntity::EntityType typeB, float thresholdX, float thresholdY, EngineFrame &frame) {
-    auto tempEntities = entities; // Copy to avoid iterator invalidation
-
-    for (auto& [idA, entityA] : tempEntities) {
+    for (auto& [idA, entityA] : entities) {
         if (entityA.getType() != typeA) continue;
         auto [posXA, posYA] = getEntityPosition(idA);
 
-        for (auto& [idB, entityB] : tempEntities) {
+        for (auto& [idB, entityB] : entities) {
             if (entityB.getType() != typeB || idA == idB) continue;
 
             auto [posXB, posYB] = getEntityPosition(idB);
 
             if (std::abs(posXA - posXB) < thresholdX && std::abs(posYA - posYB) < thresholdY) {
-                if (entities.find(idA) != entities.end() && entityA.getType() == GeneralEntity::EntityType::Player) {
+                if (entityA.getType() == GeneralEntity::EntityType::Player) {
                     lastPlayerHit = (idA == 0) ? 1 : 2;
                 }
             }
@@ -175,29 +162,32 @@ void Pong::checkCollisions(GeneralEntity::EntityType typeA, GeneralEntity::Entit
     }
 }
 
-void Pong::initializeplayers(int numPlayers, EngineFrame &frame) {
-    for (int i = playerSpawned; i < numPlayers && playerSpawned < maxPlayers; ++i) {
-        frame.frameInfos += m_server->createPacket(Network::PacketType::CREATE_BACKGROUND, "-100;0;0/");
-        if (playerSpawned == 0) {
-            spawnEntity(GeneralEntity::EntityType::Player, 100.0f, 360.0f, frame);
-            playerSpawned++;
-        } else if (playerSpawned == 1) {
-            spawnEntity(GeneralEntity::EntityType::Player, 1100.0f, 360.0f, frame);
-            playerSpawned++;
-        }
-        frame.frameInfos += m_server->createPacket(Network::PacketType::IMPORTANT_PACKET, "-1;-1;-1/");
+// Clients are known by their server id, unique across matches, not by their
+// rank in this one.
+void Pong::initializeplayers(const std::map<uint32_t, ClientRegister>& clients, EngineFrame &frame) {
+    for (const auto& [clientId, client] : clients) {
+        if (playerSpawned >= maxPlayers)
+            break;
+        if (clientToEntity.count(clientId))
+            continue;
+        frame.add(Network::PacketType::CREATE_BACKGROUND, -100, 0.0f, 0.0f);
+        float x = playerSpawned == 0 ? 100.0f : 1100.0f;
+        clientToEntity[clientId] = spawnEntity(GeneralEntity::EntityType::Player, x, 360.0f, frame);
+        playerSpawned++;
+        frame.add(Network::PacketType::IMPORTANT_PACKET);
     }
 }
 
 void Pong::CheckWinCondition(EngineFrame &frame) {
     if (gameOver) {
-        frame.frameInfos += m_server->createPacket(Network::PacketType::WIN, "-1;-1;-1/");
+        frame.add(Network::PacketType::WIN);
     }
 }
 
 void Pong::update(EngineFrame &frame) {
+    registry.advance_tick();
     registry.run_systems();
-    initializeplayers(m_server->getClients().size(), frame);
+    initializeplayers(m_server->getMatchClients(matchId), frame);
     processPlayerActions(frame);
 
     if (currentBalls < maxBalls && playerSpawned == 2) {
@@ -209,20 +199,10 @@ void Pong::update(EngineFrame &frame) {
     CheckWinCondition(frame);
 }
 
-void Pong::run(int numPlayers) {
-    int frameId = 0;
-    int last_frame_sent = 0;
-
-    while (true) {
-        if (frameClock.getElapsedTime() >= frameDuration) {
-            frameClock.restart();
-            EngineFrame new_frame;
-            m_server->server_mutex.lock();
-            update(new_frame);
-            engineFrames.emplace(frameId++, new_frame);
-            m_server->server_mutex.unlock();
-        }
-    }
+void Pong::step() {
+    EngineFrame new_frame;
+    update(new_frame);
+    engineFrames.emplace(frameId++, new_frame);
 }
 
 void Pong::handlePlayerMove(int playerId, int actionId) {
@@ -235,7 +215,8 @@ void Pong::handlePlayerMove(int playerId, int actionId) {
     } else if (actionId == 4) { // Down
         y = moveDistance;
     }
-    auto it = entities.find(playerId);
+    auto player = clientToEntity.find(playerId);
+    auto it = player != clientToEntity.end() ? entities.find(player->second) : entities.end();
     if (it != entities.end()) {
         it->second.move(x, y);
     } else {
@@ -244,7 +225,7 @@ void Pong::handlePlayerMove(int playerId, int actionId) {
 }
 
 float Pong::randomFloat(float min, float max) {
-    return min + static_cast<float>(std::rand()) / (RAND_MAX / (max - min));
+    return std::uniform_real_distribution<float>(min, max)(rng);
 }
 
 void Pong::spawnBallRandomly(EngineFrame &frame) {
@@ -262,6 +243,6 @@ size_t Pong::getEntityCount() const {
     return entities.size();
 }
 
-extern "C" AGame* create_game(void* server) {
-    return new Pong(static_cast<RType::Server*>(server));
+extern "C" AGame* create_game(void* server, uint32_t matchId) {
+    return new Pong(static_cast<RType::Server*>(server), matchId);
 }
@@ -13,11 +13,17 @@ using boost::asio::ip::udp;
 
 class ClientRegister {
     public:
-        ClientRegister(size_t id, udp::endpoint endpoint): _id(id), _endpoint(endpoint) {}
+        ClientRegister(size_t id, udp::endpoint endpoint, uint32_t matchId = 0): _id(id), _endpoint(endpoint), _matchId(matchId) {}
         size_t getId() const { return _id; };
         udp::endpoint getEndpoint() const { return _endpoint; };
+        uint32_t getMatchId() const { return _matchId; };
+        // Newest frame the client acknowledged, -1 before the first one.
+        int64_t getLastAckedFrame() const { return _lastAckedFrame; };
+        void setLastAckedFrame(int64_t frameId) { _lastAckedFrame = frameId; };
 
     private:
         size_t _id;
         udp::endpoint _endpoint;
+        uint32_t _matchId;
+        int64_t _lastAckedFrame = -1;
 };
@@ -0,0 +1,89 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** MatchManager
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AGame.hpp"
+#include "ThreadPool.hpp"
+#include "WireProtocol.hpp"
+
+namespace RType {
+    class Server;
+
+    // One hosted game. The mutex is held while the game steps and while the
+    // server reads its frames and registry to send them.
+    struct Match {
+        Match(uint32_t id, AGame* game) : id(id), game(game) {}
+
+        uint32_t id;
+        std::unique_ptr<AGame> game;
+        std::mutex mutex;
+        std::atomic<bool> running{false};
+
+        // Send state of Server::run for this match: the replicated entities
+        // sorted by id, and their value in the last frames sent, which
+        // clients may have acknowledged.
+        tick_t lastSyncTick = 0;
+        std::vector<Network::EntityState> entities;
+        std::deque<std::pair<int, std::vector<Network::EntityState>>> snapshots;
+    };
+
+    /**
+     * @brief Hosts any number of independent games in the server process.
+     *
+     * Matches are created the first time a client asks for their id and live
+     * until their last client leaves. run() is the scheduler: it sleeps until
+     * the earliest running match is due, then steps every due match as one
+     * batch on a fixed pool of workers, so a match never steps on two threads
+     * at once and the thread count does not grow with the number of matches.
+     */
+    class MatchManager {
+    public:
+        using CreateGameFunc = AGame* (*)(void*, uint32_t);
+
+        MatchManager(Server& server, CreateGameFunc createGame, size_t workers = thread_pool::default_workers());
+        ~MatchManager();
+
+        std::shared_ptr<Match> getOrCreate(uint32_t matchId);
+        std::shared_ptr<Match> find(uint32_t matchId);
+        std::vector<std::shared_ptr<Match>> getMatches();
+        void startMatch(uint32_t matchId);
+        void closeMatch(uint32_t matchId);
+
+        void run();
+        void stop();
+
+        // Blocks until a batch of steps ends after the seen-th one, or until
+        // the deadline. Updates seen and returns whether a batch ended.
+        bool waitForSteps(uint64_t& seen, std::chrono::steady_clock::time_point deadline);
+
+    private:
+        // Longest sleep of run() while no match is running.
+        static constexpr std::chrono::milliseconds idleWait{100};
+
+        Server& m_server;
+        CreateGameFunc m_createGame;
+        thread_pool m_pool;
+        std::map<uint32_t, std::shared_ptr<Match>> m_matches;
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        // Batches of steps done so far, for the threads sending the frames.
+        uint64_t m_steps = 0;
+        std::condition_variable m_stepped;
+        bool m_stopped = false;
+    };
+}
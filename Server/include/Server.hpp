@@ -14,12 +14,15 @@
 #include <iostream>
 #include <queue>
 #include <map>
+#include <optional>
 #include <boost/asio/steady_timer.hpp>
 
 #include "ThreadSafeQueue.hpp"
 #include "Packet.hpp"
+#include "WireProtocol.hpp"
 #include "ClientRegister.hpp"
 #include "GameState.hpp"
+#include "UdpBatch.hpp"
 
 typedef std::map<uint32_t, ClientRegister> ClientList;
 
@@ -28,57 +31,72 @@ typedef std::map<uint32_t, ClientRegister> ClientList;
 using namespace boost::placeholders; // Used for Boost.Asio asynchronous operations to bind placeholders for callback functions
 
 namespace RType {
+    class MatchManager;
+    struct Match;
+
     class Server {
     public:
-        Server(boost::asio::io_context& io_context, short port, ThreadSafeQueue<Network::Packet>& packetQueue, GameState* game = nullptr);
+        // Broadcast() target reaching the clients of every match.
+        static constexpr uint32_t allMatches = UINT32_MAX;
+
+        Server(boost::asio::io_context& io_context, short port, ThreadSafeQueue<Network::Packet>& packetQueue);
         ~Server();
 
         void run();
-        void handle_receive(const boost::system::error_code& error, std::size_t bytes_transferred);
+        void handle_receive(const boost::system::error_code& error);
         void send_to_client(const std::string& message, const boost::asio::ip::udp::endpoint& client_endpoint);
-        void setGameState(AGame* game);
-        void Broadcast(const std::string& message);
-        void SendFrame(EngineFrame &frame, int frameId);
-        void PacketFactory(EngineFrame &frame);
-        bool hasPositionChanged(int id, float x, float y, std::unordered_map<int, std::pair<float, float>>& lastKnownPositions);
-        void sendAllEntitiesToNewClients(EngineFrame &frame);
+        void setMatchManager(MatchManager* matches);
+        void Broadcast(const std::string& message, uint32_t matchId = allMatches);
+        void SendTo(const std::string& message, std::vector<udp::endpoint> endpoints);
+        void SendFrame(EngineFrame &frame, int frameId, uint32_t matchId);
+        void SendFrame(EngineFrame &frame, int frameId, Match &match);
+        void PacketFactory(Match &match, int frameId);
+        void mergeFrames(std::map<int, EngineFrame>::iterator first, std::map<int, EngineFrame>::iterator last);
+        void acknowledgeFrame(const udp::endpoint& endpoint, int frameId);
+        void setPositionPrecision(unsigned bits);
+        static std::optional<Network::PacketType> entityKind(GeneralEntity::EntityType type);
         void resendImportPackets();
         void SendLatencyCheck();
 
-        Network::ReqConnect reqConnectData(boost::asio::ip::udp::endpoint& client_endpoint);
+        Network::ReqConnect reqConnectData(boost::asio::ip::udp::endpoint& client_endpoint, uint32_t matchId);
         Network::DisconnectData disconnectData(boost::asio::ip::udp::endpoint& client_endpoint);
         Network::Packet deserializePacket(const std::string& packet_str);
-        std::string createPacket(const Network::PacketType& type, const std::string& data);
+        std::string createPacket(Network::PacketType type, int32_t id = -1, float x = -1.0f, float y = -1.0f);
 
         const ClientList& getClients() const { return clients_; }
-        const udp::endpoint& getRemoteEndpoint() const { return remote_endpoint_; }
+        ClientList getMatchClients(uint32_t matchId);
+        std::optional<ClientRegister> findClient(const udp::endpoint& endpoint);
 
         ClientList clients_;
         uint32_t _nbClients;
         std::mutex clients_mutex_;
         std::mutex server_mutex;
-        bool m_running;
-        std::map<int, std::pair<EngineFrame, sf::Clock>> unacknowledgedPackets;
+        // Keyed by match id then frame id: every match numbers its own frames.
+        std::map<std::pair<uint32_t, int>, std::pair<EngineFrame, sf::Clock>> unacknowledgedPackets;
 
     private:
         using PacketHandler = std::function<void(const std::vector<std::string>&)>;
         void start_receive();
-        uint32_t createClient(boost::asio::ip::udp::endpoint& client_endpoint);
+        void handle_datagram(const char* data, std::size_t size, const udp::endpoint& endpoint);
+        uint32_t createClient(boost::asio::ip::udp::endpoint& client_endpoint, uint32_t matchId);
         void start_send_timer();
         void handle_send_timer(const boost::system::error_code& error);
 
         udp::socket socket_;
-        udp::endpoint remote_endpoint_;
-        std::array<char, MAX_LENGTH> recv_buffer_;
+        UdpBatch m_batch;
         ThreadSafeQueue<Network::Packet>& m_packetQueue;
         std::unordered_map<std::string, std::function<void(const std::vector<std::string>&)>> packet_handlers_;
         std::unordered_map<Network::PacketType, void(*)(const Network::Packet&)> m_handlers;
-        AGame* m_game;
-        std::queue<std::string> send_queue_;
+        MatchManager* m_matches;
+        std::queue<std::pair<uint32_t, std::string>> send_queue_;
+        std::queue<std::pair<std::vector<udp::endpoint>, std::string>> direct_queue_;
+        Network::PositionQuantiser m_quantiser;
         boost::asio::steady_timer send_timer_;
         std::queue<uint32_t> available_ids_;
         sf::Clock latencyClock;
         const sf::Time LatencyRefreshDuration = sf::milliseconds(200);
+        sf::Clock resendClock;
+        const sf::Time ResendInterval = sf::milliseconds(3);
     };
 }
 
@@ -0,0 +1,61 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** UdpBatch
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <boost/asio.hpp>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+namespace RType {
+    /**
+     * @brief Sends and receives datagrams on a UDP socket in batches.
+     *
+     * On Linux a batch of up to maxBatch datagrams costs one sendmmsg or
+     * recvmmsg call. Elsewhere every datagram is its own call. Both calls
+     * never block: datagrams the socket cannot take right now go through
+     * asio's asynchronous sends instead.
+     *
+     * Not thread safe: meant for the thread running the socket's io_context.
+     */
+    class UdpBatch {
+    public:
+        static constexpr size_t maxBatch = 64;
+        static constexpr size_t maxDatagram = 4096;
+
+        using ReceiveFunc = std::function<void(const char* data, size_t size, const boost::asio::ip::udp::endpoint& endpoint)>;
+
+        explicit UdpBatch(boost::asio::ip::udp::socket& socket);
+
+        // Queues one datagram for every endpoint. Its bytes are kept once.
+        void queue(std::string datagram, const std::vector<boost::asio::ip::udp::endpoint>& endpoints);
+        // Sends what was queued and returns the number of system calls made.
+        size_t flush();
+        // Calls f for every datagram waiting on the socket, and returns their number.
+        size_t receive(const ReceiveFunc& f);
+
+    private:
+        void sendAsync(const std::string& datagram, const boost::asio::ip::udp::endpoint& endpoint);
+
+        boost::asio::ip::udp::socket& m_socket;
+        std::vector<std::string> m_datagrams;
+        std::vector<std::pair<size_t, boost::asio::ip::udp::endpoint>> m_pending;
+        std::vector<std::array<char, maxDatagram>> m_buffers;
+#ifdef __linux__
+        std::vector<mmsghdr> m_messages;
+        std::vector<iovec> m_iovecs;
+        std::vector<sockaddr_storage> m_addresses;
+#endif
+    };
+}
@@ -10,6 +10,7 @@
 #include "Packet.hpp"
 #include "ThreadSafeQueue.hpp"
 #include "PacketHandler.hpp"
+#include "MatchManager.hpp"
 #include "GameState.hpp"
 #include <dlfcn.h>
 
@@ -31,7 +32,7 @@ void runServer(short port, const std::string& gameName) {
         boost::asio::io_context io_context;
         ThreadSafeQueue<Network::Packet> packetQueue;
 
-        RType::Server server(io_context, port, packetQueue, nullptr);
+        RType::Server server(io_context, port, packetQueue);
 
         // Load the correct game library based on the game name
         std::string libPath = "./R-Type/lib" + gameName + ".so";
@@ -42,8 +43,7 @@ void runServer(short port, const std::string& gameName) {
         }
 
         // Load the factory function
-        typedef AGame* (*CreateGameFunc)(void*);
-        CreateGameFunc create_game = (CreateGameFunc)dlsym(handle, "create_game");
+        auto create_game = (RType::MatchManager::CreateGameFunc)dlsym(handle, "create_game");
 
         if (!create_game) {
             std::cerr << "Error loading function: " << dlerror() << std::endl;
@@ -51,26 +51,30 @@ void runServer(short port, const std::string& gameName) {
             return;
         }
 
-        // Create an instance of the game dynamically
-        AGame* game = create_game(&server);
-        server.setGameState(game);  // Set the game dynamically
+        {
+            // Every match gets its own instance of the game, created on first join
+            RType::MatchManager matches(server, create_game);
+            server.setMatchManager(&matches);
 
-        // Start handling packets
-        Network::PacketHandler packetHandler(packetQueue, *game, server);
-        packetHandler.start();
+            // Start handling packets
+            Network::PacketHandler packetHandler(packetQueue, matches, server);
+            packetHandler.start();
 
-        std::cout << "Server started\nListening on UDP port " << port << " running " << gameName << std::endl;
+            std::cout << "Server started\nListening on UDP port " << port << " running " << gameName << std::endl;
 
-        std::thread io_thread([&io_context] { io_context.run(); });
-        std::thread serverThread([&server] { server.run(); });
+            std::thread io_thread([&io_context] { io_context.run(); });
+            std::thread serverThread([&server] { server.run(); });
+            std::thread matchThread([&matches] { matches.run(); });
 
-        if (io_thread.joinable()) io_thread.join();
-        if (serverThread.joinable()) serverThread.join();
+            if (io_thread.joinable()) io_thread.join();
+            if (serverThread.joinable()) serverThread.join();
 
-        packetHandler.stop();
+            matches.stop();
+            if (matchThread.joinable()) matchThread.join();
+            packetHandler.stop();
+        }
 
-        // Cleanup
-        delete game;
+        // Cleanup, once the games built by the library are gone
         dlclose(handle);
 
     } catch (const boost::system::system_error& e) {
@@ -0,0 +1,134 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** MatchManager
+*/
+
+#include "MatchManager.hpp"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+RType::MatchManager::MatchManager(Server& server, CreateGameFunc createGame, size_t workers)
+: m_server(server), m_createGame(createGame), m_pool(workers)
+{
+}
+
+RType::MatchManager::~MatchManager()
+{
+    stop();
+}
+
+std::shared_ptr<RType::Match> RType::MatchManager::getOrCreate(uint32_t matchId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_matches.find(matchId);
+    if (it == m_matches.end()) {
+        auto match = std::make_shared<Match>(matchId, m_createGame(&m_server, matchId));
+        it = m_matches.emplace(matchId, std::move(match)).first;
+        std::cout << "[MatchManager] Match " << matchId << " created." << std::endl;
+    }
+    return it->second;
+}
+
+std::shared_ptr<RType::Match> RType::MatchManager::find(uint32_t matchId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_matches.find(matchId);
+    return it != m_matches.end() ? it->second : nullptr;
+}
+
+std::vector<std::shared_ptr<RType::Match>> RType::MatchManager::getMatches()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::shared_ptr<Match>> matches;
+    matches.reserve(m_matches.size());
+    for (const auto& [id, match] : m_matches) {
+        matches.push_back(match);
+    }
+    return matches;
+}
+
+void RType::MatchManager::startMatch(uint32_t matchId)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_matches.find(matchId);
+        if (it == m_matches.end() || it->second->running) {
+            return;
+        }
+        it->second->game->getClock().reset();
+        it->second->running = true;
+    }
+    m_cond.notify_one();
+}
+
+// A match stepping right now is destroyed once its step is over.
+void RType::MatchManager::closeMatch(uint32_t matchId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_matches.erase(matchId) != 0) {
+        std::cout << "[MatchManager] Match " << matchId << " closed." << std::endl;
+    }
+}
+
+void RType::MatchManager::run()
+{
+    std::vector<std::shared_ptr<Match>> due;
+    std::vector<std::function<void()>> tasks;
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_stopped) {
+        GameClock::Clock::time_point wakeUp = GameClock::Clock::now() + idleWait;
+        for (const auto& [id, match] : m_matches) {
+            if (!match->running) {
+                continue;
+            }
+            GameClock& clock = match->game->getClock();
+            if (clock.tryStep()) {
+                due.push_back(match);
+            }
+            wakeUp = std::min(wakeUp, clock.getNextStep());
+        }
+        if (due.empty()) {
+            m_cond.wait_until(lock, wakeUp);
+            continue;
+        }
+        lock.unlock();
+        for (const auto& match : due) {
+            tasks.emplace_back([&match] {
+                std::lock_guard<std::mutex> guard(match->mutex);
+                match->game->step();
+            });
+        }
+        try {
+            m_pool.run(tasks);
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR] Match step failed: " << e.what() << std::endl;
+        }
+        tasks.clear();
+        due.clear();
+        lock.lock();
+        ++m_steps;
+        m_stepped.notify_all();
+    }
+}
+
+void RType::MatchManager::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+    }
+    m_cond.notify_all();
+    m_stepped.notify_all();
+}
+
+bool RType::MatchManager::waitForSteps(uint64_t& seen, std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    bool stepped = m_stepped.wait_until(lock, deadline, [this, &seen] { return m_steps != seen || m_stopped; });
+    seen = m_steps;
+    return stepped;
+}
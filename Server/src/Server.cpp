@@ -6,7 +6,10 @@
 */
 
 #include "Server.hpp"
+#include "MatchManager.hpp"
 #include "DataPacking.hpp"
+#include "Position.hpp"
+#include <algorithm>
 
 using boost::asio::ip::udp;
 
@@ -19,8 +22,8 @@ using boost::asio::ip::udp;
  * @param io_context The io_context object used for asynchronous operations.
  * @param port The port number on which the server will listen for incoming UDP packets.
  */
-RType::Server::Server(boost::asio::io_context& io_context, short port, ThreadSafeQueue<Network::Packet>& packetQueue, GameState* game)
-: socket_(io_context, udp::endpoint(udp::v4(), port)), m_packetQueue(packetQueue), m_game(game), _nbClients(0), m_running(false), send_timer_(io_context) // Initialize send_timer_
+RType::Server::Server(boost::asio::io_context& io_context, short port, ThreadSafeQueue<Network::Packet>& packetQueue)
+: socket_(io_context, udp::endpoint(udp::v4(), port)), m_batch(socket_), m_packetQueue(packetQueue), m_matches(nullptr), _nbClients(0), send_timer_(io_context) // Initialize send_timer_
 {
     start_receive();
     start_send_timer(); // Start the send timer
@@ -31,8 +34,8 @@ RType::Server::~Server()
     socket_.close();
 }
 
-void RType::Server::setGameState(AGame* game) {
-    m_game = game;
+void RType::Server::setMatchManager(MatchManager* matches) {
+    m_matches = matches;
 }
 
 //SEND MESSAGES
@@ -49,56 +52,66 @@ void RType::Server::send_to_client(const std::string& message, const udp::endpoi
         });
 }
 
-void RType::Server::Broadcast(const std::string& message)
+void RType::Server::Broadcast(const std::string& message, uint32_t matchId)
 {
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
-        send_queue_.push(message); // Add to queue
+        send_queue_.emplace(matchId, message); // Add to queue
     }
 }
 
+void RType::Server::SendTo(const std::string& message, std::vector<udp::endpoint> endpoints)
+{
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    direct_queue_.emplace(std::move(endpoints), message);
+}
+
 /**
- * @brief Starts an asynchronous receive operation.
+ * @brief Waits asynchronously for datagrams to read.
  *
- * This function initiates an asynchronous receive operation to receive data
- * from a remote endpoint. When data is received, the provided handler function
- * is called to process the received data.
+ * When the socket becomes readable, handle_receive drains every datagram
+ * waiting on it in batches, then waits again.
  */
 void RType::Server::start_receive()
 {
-    socket_.async_receive_from(
-        boost::asio::buffer(recv_buffer_), remote_endpoint_,
+    socket_.async_wait(udp::socket::wait_read,
         boost::bind(&RType::Server::handle_receive, this,
-                    boost::asio::placeholders::error,
-                    boost::asio::placeholders::bytes_transferred));
+                    boost::asio::placeholders::error));
 }
 
 /**
- * @brief Handles the completion of an asynchronous receive operation.
+ * @brief Handles the socket becoming readable.
  *
- * This function is called when data is received from a remote endpoint. It processes
- * the received data, optionally sends a response back to the client, and restarts
- * the asynchronous receive operation to handle the next incoming message.
+ * Every waiting datagram is unpacked and queued for the packet handler,
+ * with the endpoint it came from, before the next wait starts.
  *
- * @param error The error code indicating the result of the receive operation.
- * @param bytes_transferred The number of bytes received.
+ * @param error The error code indicating the result of the wait.
  */
 
-void RType::Server::handle_receive(const boost::system::error_code &error, std::size_t bytes_transferred)
+void RType::Server::handle_receive(const boost::system::error_code &error)
 {
-    if (!error || error == boost::asio::error::message_size) {
-        std::string received_data(recv_buffer_.data(), bytes_transferred);
-        std::string unpacked_data = DataPacking::decompressData(received_data);
-        Network::Packet packet;
-        packet.type = deserializePacket(unpacked_data).type;
-        packet.rawData = unpacked_data;
-        m_packetQueue.push(packet);
-        start_receive();
-    }
-    else {
+    if (!error) {
+        m_batch.receive([this](const char* data, std::size_t size, const udp::endpoint& endpoint) {
+            handle_datagram(data, size, endpoint);
+        });
+    } else {
         std::cerr << "[ERROR] Error receiving: " << error.message() << std::endl;
-        start_receive();
     }
+    start_receive();
+}
+
+void RType::Server::handle_datagram(const char* data, std::size_t size, const udp::endpoint& endpoint)
+{
+    std::string unpacked_data = DataPacking::decompressData(std::string(data, size));
+    if (unpacked_data.empty()) {
+        std::cerr << "[ERROR] Invalid datagram of " << size << " bytes." << std::endl;
+        return;
+    }
+    Network::Packet packet;
+    packet.type = deserializePacket(unpacked_data).type;
+    packet.rawData = unpacked_data;
+    packet.endpoint = endpoint;
+    m_packetQueue.push(packet);
 }
 
 Network::Packet RType::Server::deserializePacket(const std::string& packet_str)
@@ -108,20 +121,17 @@ Network::Packet RType::Server::deserializePacket(const std::string& packet_str)
     return packet;
 }
 
-std::string RType::Server::createPacket(const Network::PacketType& type, const std::string& data)
+// Control message: a datagram of the given type holding a single record.
+std::string RType::Server::createPacket(Network::PacketType type, int32_t id, float x, float y)
 {
-    std::string packet_str;
-    std::string packet_data = data.empty() ? "-1;-1;-1/" : data;
+    Network::EntityRecord record{type, id, x, y};
+    std::string packet_str(Network::Wire::encodedSize(1), '\0');
 
-    packet_str.push_back(static_cast<uint8_t>(type));
-    packet_str.push_back(static_cast<uint8_t>(';'));
-    for (char c : packet_data) {   
-        packet_str.push_back(static_cast<uint8_t>(c));
-    }
+    Network::Wire::encode(reinterpret_cast<uint8_t*>(packet_str.data()), packet_str.size(), type, 0, &record, 1);
     return packet_str;
 }
 
-uint32_t RType::Server::createClient(boost::asio::ip::udp::endpoint& client_endpoint)
+uint32_t RType::Server::createClient(boost::asio::ip::udp::endpoint& client_endpoint, uint32_t matchId)
 {
     uint32_t nb;
     {
@@ -136,24 +146,25 @@ uint32_t RType::Server::createClient(boost::asio::ip::udp::endpoint& client_endp
             available_ids_.pop();
         } else
             nb = this->_nbClients++;
-        ClientRegister newClient(nb, client_endpoint);
+        ClientRegister newClient(nb, client_endpoint, matchId);
         clients_.insert(std::make_pair(nb, newClient));
     }
     return nb;
 }
 
-Network::ReqConnect RType::Server::reqConnectData(boost::asio::ip::udp::endpoint& client_endpoint)
+Network::ReqConnect RType::Server::reqConnectData(boost::asio::ip::udp::endpoint& client_endpoint, uint32_t matchId)
 {
     Network::ReqConnect data;
     size_t idClient;
-    idClient = createClient(client_endpoint);
+    idClient = createClient(client_endpoint, matchId);
     data.id = idClient;
+    std::shared_ptr<Match> match = m_matches->getOrCreate(matchId);
     {
     std::lock_guard<std::mutex> lock(clients_mutex_);
-    if (m_running)
-        send_to_client(createPacket(Network::PacketType::GAME_STARTED, ""), client_endpoint);
+    if (match->running)
+        send_to_client(createPacket(Network::PacketType::GAME_STARTED), client_endpoint);
     else
-        send_to_client(createPacket(Network::PacketType::GAME_NOT_STARTED, ""), client_endpoint);
+        send_to_client(createPacket(Network::PacketType::GAME_NOT_STARTED), client_endpoint);
     return data;
     }
 }
@@ -161,132 +172,281 @@ Network::ReqConnect RType::Server::reqConnectData(boost::asio::ip::udp::endpoint
 Network::DisconnectData RType::Server::disconnectData(boost::asio::ip::udp::endpoint& client_endpoint)
 {
     Network::DisconnectData data;
+    uint32_t matchId = 0;
+    bool found = false;
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
 
         for (auto it = clients_.begin(); it != clients_.end(); ++it) {
             if (it->second.getEndpoint() == client_endpoint) {
                 data.id = it->second.getId();
+                matchId = it->second.getMatchId();
                 std::cout << "[DEBUG] Client " << data.id << " disconnected." << std::endl;
 
                 available_ids_.push(data.id);
 
                 clients_.erase(it);
-                return data;
+                found = true;
+                break;
             }
         }
     }
+    if (found) {
+        if (getMatchClients(matchId).empty())
+            m_matches->closeMatch(matchId);
+        return data;
+    }
     data.id = -1;
     std::cerr << "[ERROR] Client not found." << std::endl;
-    send_to_client(createPacket(Network::PacketType::NONE, ""), client_endpoint);
+    send_to_client(createPacket(Network::PacketType::NONE), client_endpoint);
     return data;
 }
 
-void RType::Server::sendAllEntitiesToNewClients(EngineFrame &frame) {
+ClientList RType::Server::getMatchClients(uint32_t matchId)
+{
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    ClientList matchClients;
+
+    for (const auto& [id, client] : clients_) {
+        if (client.getMatchId() == matchId)
+            matchClients.emplace(id, client);
+    }
+    return matchClients;
+}
+
+std::optional<ClientRegister> RType::Server::findClient(const udp::endpoint& endpoint)
+{
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+
+    for (const auto& [id, client] : clients_) {
+        if (client.getEndpoint() == endpoint)
+            return client;
+    }
+    return std::nullopt;
+}
+
+// CREATE_ packet a client builds the sprite of an entity type from.
+std::optional<Network::PacketType> RType::Server::entityKind(GeneralEntity::EntityType type) {
     static const std::unordered_map<GeneralEntity::EntityType, Network::PacketType> entityToPacketType = {
         {GeneralEntity::EntityType::Player, Network::PacketType::CREATE_PLAYER},
         {GeneralEntity::EntityType::Enemy, Network::PacketType::CREATE_ENEMY},
         {GeneralEntity::EntityType::Boss, Network::PacketType::CREATE_BOSS},
-        {GeneralEntity::EntityType::Bullet, Network::PacketType::CREATE_BULLET}
+        {GeneralEntity::EntityType::Bullet, Network::PacketType::CREATE_BULLET},
+        {GeneralEntity::EntityType::EnemyBullet, Network::PacketType::CREATE_ENEMY_BULLET},
+        {GeneralEntity::EntityType::Ball, Network::PacketType::CREATE_BALL}
     };
 
-    for (const auto& [entityId, entity] : m_game->getEntities()) {
-        try {
-            auto [x, y] = m_game->getEntityPosition(entityId);
-            auto it = entityToPacketType.find(entity.getType());
-            if (it != entityToPacketType.end()) {
-                Network::PacketType packetType = it->second;
-                std::string entityPacket = std::to_string(entityId) + ";" + std::to_string(x) + ";" + std::to_string(y) + "/";
-                frame.frameInfos += createPacket(packetType, entityPacket);
-            } else {
-                std::cerr << "[WARNING] Unknown entity type for ID: " << entityId << std::endl;
-            }
-        } catch (const std::out_of_range& e) {
-            std::cerr << "[ERROR] Invalid entity ID: " << entityId << " - " << e.what() << std::endl;
-        }
-    }
+    auto it = entityToPacketType.find(type);
+    if (it == entityToPacketType.end())
+        return std::nullopt;
+    return it->second;
 }
 
 void RType::Server::resendImportPackets() {
-    for (auto it = unacknowledgedPackets.begin(); it != unacknowledgedPackets.end(); ++it) {
+    if (resendClock.getElapsedTime() < ResendInterval)
+        return;
+    resendClock.restart();
+    for (auto it = unacknowledgedPackets.begin(); it != unacknowledgedPackets.end();) {
         if (it->second.second.getElapsedTime().asMilliseconds() < 10) {
-            SendFrame(it->second.first, it->first);
+            SendFrame(it->second.first, it->first.second, it->first.first);
+            ++it;
         } else
-            unacknowledgedPackets.erase(it);    //after 10 ms delay packet is considered as lost and will not be resent
+            it = unacknowledgedPackets.erase(it);    //after 10 ms delay packet is considered as lost and will not be resent
     }
 }
 
+// Sleeps until the matches step or the next latency check or resend is due.
+// Frames a match stepped since the last send go out as one, the newest: it
+// carries the records of the others in order, so none is lost when the
+// server falls behind, and its entity block brings every entity up to date.
 void RType::Server::run() {
     std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
-    size_t lastClientCount = clients_.size();
+    uint64_t steps = 0;
 
     while (true) {
-        server_mutex.lock();
-        if (!m_game->getEngineFrames().empty() && std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count() > 600) {
-            auto it = m_game->getEngineFrames().end();
-            --it;
-            EngineFrame frame = it->second;
-            if (!frame.sent) {
-                frame.frameInfos = std::to_string(it->first) + ":" + frame.frameInfos;
-                if (clients_.size() > lastClientCount) {
-                    lastClientCount = clients_.size();
-                    sendAllEntitiesToNewClients(frame);
-                }
-                PacketFactory(frame);
-                SendFrame(frame, it->first);
-                it->second.sent = true;
+        sf::Time wait = LatencyRefreshDuration - latencyClock.getElapsedTime();
+        if (!unacknowledgedPackets.empty())
+            wait = std::min(wait, ResendInterval - resendClock.getElapsedTime());
+        m_matches->waitForSteps(steps, std::chrono::steady_clock::now() + std::chrono::microseconds(wait.asMicroseconds()));
+
+        std::lock_guard<std::mutex> lock(server_mutex);
+        if (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count() > 600) {
+            for (const auto& match : m_matches->getMatches()) {
+                if (!match->running)
+                    continue;
+                std::lock_guard<std::mutex> matchLock(match->mutex);
+                auto& engineFrames = match->game->getEngineFrames();
+                if (engineFrames.empty())
+                    continue;
+                auto newest = std::prev(engineFrames.end());
+                if (newest->second.sent)
+                    continue;
+                auto first = newest;
+                while (first != engineFrames.begin() && !std::prev(first)->second.sent)
+                    --first;
+                if (first != newest)
+                    mergeFrames(first, newest);
+                PacketFactory(*match, newest->first);
+                SendFrame(newest->second, newest->first, *match);
+                newest->second.sent = true;
+                // Resends keep their own copy: sent frames are only kept
+                // for the window of the entity snapshots.
+                while (engineFrames.size() > Network::Wire::baselineHistory && engineFrames.begin()->second.sent)
+                    engineFrames.erase(engineFrames.begin());
             }
         }
         SendLatencyCheck();
         resendImportPackets();
-        server_mutex.unlock();
     }
 }
 
+// Moves the records of the frames [first, last) in front of those of last,
+// in order, and marks those frames sent. One important marker is kept.
+void RType::Server::mergeFrames(std::map<int, EngineFrame>::iterator first, std::map<int, EngineFrame>::iterator last)
+{
+    std::vector<Network::EntityRecord> records;
+    bool important = false;
+    auto append = [&records, &important](const std::vector<Network::EntityRecord>& from) {
+        for (const auto& record : from) {
+            if (record.type == Network::PacketType::IMPORTANT_PACKET) {
+                if (important)
+                    continue;
+                important = true;
+            }
+            records.push_back(record);
+        }
+    };
+    for (; first != last; ++first) {
+        append(first->second.records);
+        first->second.records.clear();
+        first->second.sent = true;
+    }
+    append(last->second.records);
+    last->second.records = std::move(records);
+}
+
 void RType::Server::SendLatencyCheck() {
     if (latencyClock.getElapsedTime() >= LatencyRefreshDuration) {
         latencyClock.restart();
         auto now = std::chrono::steady_clock::now();
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
 
-        std::string second_part = std::to_string(ms) + ";-1;-1/";
-        std::string packet = createPacket(Network::PacketType::LATENCY_CHECK, second_part);
+        // Clients compare against their own clock modulo 2^32.
+        std::string packet = createPacket(Network::PacketType::LATENCY_CHECK, static_cast<int32_t>(static_cast<uint32_t>(ms)));
 
         Broadcast(packet);
     }
 }
 
 
-bool RType::Server::hasPositionChanged(int id, float x, float y, std::unordered_map<int, std::pair<float, float>>& lastKnownPositions) {
-    auto it = lastKnownPositions.find(id);
-    if (it == lastKnownPositions.end() || it->second != std::make_pair(x, y)) {
-        lastKnownPositions[id] = {x, y};
-        return true;
+// Brings the replicated entities of the match up to date from what changed
+// since the last frame sent, and keeps them as the baseline of this frame.
+// Entities of a type clients cannot draw are not replicated.
+void RType::Server::PacketFactory(Match &match, int frameId)
+{
+    Registry& registry = match.game->getRegistry();
+    const auto& gameEntities = match.game->getEntities();
+    auto& entities = match.entities;
+    auto find = [&entities](uint32_t id) {
+        return std::lower_bound(entities.begin(), entities.end(), id, [](const Network::EntityState& entity, uint32_t entityId) {
+            return entity.id < entityId;
+        });
+    };
+
+    for (std::size_t entityId : registry.removed_since<Position>(match.lastSyncTick)) {
+        auto it = find(static_cast<uint32_t>(entityId));
+        if (it != entities.end() && it->id == entityId)
+            entities.erase(it);
     }
-    return false;
+    registry.view<Changed<Position>>(match.lastSyncTick).each([this, &entities, &gameEntities, &find](std::size_t entityId, const Position& pos) {
+        auto it = find(static_cast<uint32_t>(entityId));
+        if (it != entities.end() && it->id == entityId) {
+            *it = m_quantiser.quantise(it->id, it->kind, pos.x, pos.y);
+            return;
+        }
+        auto entity = gameEntities.find(static_cast<int>(entityId));
+        if (entity == gameEntities.end())
+            return;
+        if (std::optional<Network::PacketType> kind = entityKind(entity->second.getType()))
+            entities.insert(it, m_quantiser.quantise(static_cast<uint32_t>(entityId), *kind, pos.x, pos.y));
+    });
+    match.lastSyncTick = registry.tick();
+
+    match.snapshots.emplace_back(frameId, entities);
+    if (match.snapshots.size() > Network::Wire::baselineHistory)
+        match.snapshots.pop_front();
 }
 
-void RType::Server::PacketFactory(EngineFrame &frame)
-{
-    static std::unordered_map<int, std::pair<float, float>> lastKnownPositions;
-
-    for (const auto & [entityId, entity] : m_game->getEntities()) {
-        try {
-            auto [x, y] = m_game->getEntityPosition(entityId);
-            if (hasPositionChanged(entityId, x, y, lastKnownPositions)) {
-                std::string second_part = std::to_string(entityId) + ";" + std::to_string(x) + ";" + std::to_string(y) + "/";
-                frame.frameInfos += createPacket(Network::PacketType::CHANGE, second_part);
+// Entities go as a difference from the newest frame each client acknowledged,
+// so a client that lost frames or just joined gets exactly what it misses.
+// Clients on the same baseline share one datagram, packed once.
+void RType::Server::SendFrame(EngineFrame &frame, int frameId, Match &match) {
+    if (frame.isImportant())
+        unacknowledgedPackets.emplace(std::make_pair(match.id, frameId), std::make_pair(frame, sf::Clock()));
+
+    const auto& current = match.snapshots.back().second;
+    std::map<uint32_t, std::pair<std::string, std::vector<udp::endpoint>>> datagrams;
+
+    for (const auto& [id, client] : getMatchClients(match.id)) {
+        uint32_t baselineId = Network::Wire::noBaseline;
+        const std::vector<Network::EntityState>* baseline = nullptr;
+        for (const auto& [snapshotId, entities] : match.snapshots) {
+            if (snapshotId == client.getLastAckedFrame()) {
+                baselineId = static_cast<uint32_t>(snapshotId);
+                baseline = &entities;
             }
-        } catch (const std::out_of_range& e) {
-            std::cerr << "[ERROR] Invalid entity ID: " << entityId << " - " << e.what() << std::endl;
         }
+
+        auto datagram = datagrams.find(baselineId);
+        if (datagram == datagrams.end()) {
+            size_t baselineCount = baseline ? baseline->size() : 0;
+            std::string packed(Network::Wire::encodedSize(frame.records.size()) + Network::Wire::entityBlockBound(current.size(), baselineCount), '\0');
+            uint8_t* out = reinterpret_cast<uint8_t*>(packed.data());
+            size_t size = Network::Wire::encode(out, packed.size(), Network::PacketType::FRAME, frameId, frame.records.data(), frame.records.size());
+            if (size)
+                size = Network::Wire::appendEntities(out, size, packed.size(), m_quantiser, baselineId, current.data(), current.size(),
+                    baseline ? baseline->data() : nullptr, baselineCount);
+            if (!size) {
+                std::cerr << "[ERROR] Frame " << frameId << " has too many records to be sent." << std::endl;
+                return;
+            }
+            packed.resize(size);
+            datagram = datagrams.emplace(baselineId, std::make_pair(std::move(packed), std::vector<udp::endpoint>())).first;
+        }
+        datagram->second.second.push_back(client.getEndpoint());
     }
+    for (auto& [baselineId, datagram] : datagrams)
+        SendTo(datagram.first, std::move(datagram.second));
 }
 
-void RType::Server::SendFrame(EngineFrame &frame, int frameId) {
-    if (frame.frameInfos.find("33;-1;-1;-1/") != std::string::npos)
-        unacknowledgedPackets.emplace(frameId, std::make_pair(frame, sf::Clock()));
-    Broadcast(frame.frameInfos);
+// Resent frames carry their records only: their entity block is stale by now.
+void RType::Server::SendFrame(EngineFrame &frame, int frameId, uint32_t matchId) {
+    if (frame.isImportant())
+        unacknowledgedPackets.emplace(std::make_pair(matchId, frameId), std::make_pair(frame, sf::Clock()));
+    std::string datagram(Network::Wire::encodedSize(frame.records.size()), '\0');
+    if (!Network::Wire::encode(reinterpret_cast<uint8_t*>(datagram.data()), datagram.size(), Network::PacketType::FRAME, frameId, frame.records.data(), frame.records.size())) {
+        std::cerr << "[ERROR] Frame " << frameId << " has too many records to be sent." << std::endl;
+        return;
+    }
+    Broadcast(datagram, matchId);
+}
+
+void RType::Server::acknowledgeFrame(const udp::endpoint& endpoint, int frameId)
+{
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+
+    for (auto& [id, client] : clients_) {
+        if (client.getEndpoint() == endpoint) {
+            if (frameId > client.getLastAckedFrame())
+                client.setLastAckedFrame(frameId);
+            return;
+        }
+    }
+}
+
+void RType::Server::setPositionPrecision(unsigned bits)
+{
+    m_quantiser.bits = std::clamp(bits, 1u, 16u);
 }
 
 void RType::Server::start_send_timer() {
@@ -294,16 +454,30 @@ void RType::Server::start_send_timer() {
     send_timer_.async_wait(boost::bind(&Server::handle_send_timer, this, boost::asio::placeholders::error));
 }
 
+// Every queued message is packed once, whatever its number of recipients,
+// and the whole tick goes out through the batch.
 void RType::Server::handle_send_timer(const boost::system::error_code& error) {
     if (!error) {
-        std::lock_guard<std::mutex> lock(clients_mutex_);
-        if (!send_queue_.empty()) {
-            std::string message = send_queue_.front();
-            send_queue_.pop();
-            for (const auto& client : clients_) {
-                send_to_client(message, client.second.getEndpoint());
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex_);
+            // Drained at once: with many matches one message per tick would fall behind.
+            while (!send_queue_.empty()) {
+                const auto& [matchId, message] = send_queue_.front();
+                std::vector<udp::endpoint> endpoints;
+                for (const auto& client : clients_) {
+                    if (matchId == allMatches || client.second.getMatchId() == matchId)
+                        endpoints.push_back(client.second.getEndpoint());
+                }
+                if (!endpoints.empty())
+                    m_batch.queue(DataPacking::compressData(message), endpoints);
+                send_queue_.pop();
+            }
+            while (!direct_queue_.empty()) {
+                m_batch.queue(DataPacking::compressData(direct_queue_.front().second), direct_queue_.front().first);
+                direct_queue_.pop();
             }
         }
+        m_batch.flush();
         start_send_timer();
     } else {
         std::cerr << "[DEBUG] Timer error: " << error.message() << std::endl;
@@ -0,0 +1,138 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** UdpBatch
+*/
+
+#include "UdpBatch.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+using boost::asio::ip::udp;
+
+RType::UdpBatch::UdpBatch(udp::socket& socket) : m_socket(socket), m_buffers(maxBatch)
+{
+#ifdef __linux__
+    m_messages.resize(maxBatch);
+    m_iovecs.resize(maxBatch);
+    m_addresses.resize(maxBatch);
+#endif
+}
+
+void RType::UdpBatch::queue(std::string datagram, const std::vector<udp::endpoint>& endpoints)
+{
+    if (endpoints.empty())
+        return;
+    m_datagrams.push_back(std::move(datagram));
+    for (const auto& endpoint : endpoints)
+        m_pending.emplace_back(m_datagrams.size() - 1, endpoint);
+}
+
+void RType::UdpBatch::sendAsync(const std::string& datagram, const udp::endpoint& endpoint)
+{
+    auto data = std::make_shared<std::string>(datagram);
+    m_socket.async_send_to(boost::asio::buffer(*data), endpoint,
+        [data](const boost::system::error_code& error, std::size_t) {
+            if (error)
+                std::cerr << "[ERROR] Error sending to client: " << error.message() << std::endl;
+        });
+}
+
+size_t RType::UdpBatch::flush()
+{
+    size_t calls = 0;
+#ifdef __linux__
+    size_t sent = 0;
+    while (sent < m_pending.size()) {
+        size_t count = std::min(maxBatch, m_pending.size() - sent);
+        for (size_t i = 0; i < count; ++i) {
+            const auto& [datagram, endpoint] = m_pending[sent + i];
+            m_iovecs[i].iov_base = m_datagrams[datagram].data();
+            m_iovecs[i].iov_len = m_datagrams[datagram].size();
+            std::memset(&m_messages[i], 0, sizeof(mmsghdr));
+            m_messages[i].msg_hdr.msg_name = const_cast<sockaddr*>(endpoint.data());
+            m_messages[i].msg_hdr.msg_namelen = static_cast<socklen_t>(endpoint.size());
+            m_messages[i].msg_hdr.msg_iov = &m_iovecs[i];
+            m_messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        int result = sendmmsg(m_socket.native_handle(), m_messages.data(), static_cast<unsigned>(count), MSG_DONTWAIT);
+        ++calls;
+        if (result > 0) {
+            sent += static_cast<size_t>(result);
+        } else if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // The socket buffer is full: let asio wait for room.
+            for (; sent < m_pending.size(); ++sent)
+                sendAsync(m_datagrams[m_pending[sent].first], m_pending[sent].second);
+        } else {
+            // Only the first datagram of the batch failed; drop it and go on.
+            std::cerr << "[ERROR] Error sending to client: " << std::strerror(errno) << std::endl;
+            ++sent;
+        }
+    }
+#else
+    for (const auto& [datagram, endpoint] : m_pending) {
+        sendAsync(m_datagrams[datagram], endpoint);
+        ++calls;
+    }
+#endif
+    m_pending.clear();
+    m_datagrams.clear();
+    return calls;
+}
+
+size_t RType::UdpBatch::receive(const ReceiveFunc& f)
+{
+    size_t received = 0;
+#ifdef __linux__
+    while (true) {
+        for (size_t i = 0; i < maxBatch; ++i) {
+            m_iovecs[i].iov_base = m_buffers[i].data();
+            m_iovecs[i].iov_len = m_buffers[i].size();
+            std::memset(&m_messages[i], 0, sizeof(mmsghdr));
+            m_messages[i].msg_hdr.msg_name = &m_addresses[i];
+            m_messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            m_messages[i].msg_hdr.msg_iov = &m_iovecs[i];
+            m_messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        int result = recvmmsg(m_socket.native_handle(), m_messages.data(), static_cast<unsigned>(maxBatch), MSG_DONTWAIT, nullptr);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                std::cerr << "[ERROR] Error receiving: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        for (int i = 0; i < result; ++i) {
+            udp::endpoint endpoint;
+            // Datagrams larger than the buffer arrive cut short: drop them.
+            if ((m_messages[i].msg_hdr.msg_flags & MSG_TRUNC) || m_messages[i].msg_hdr.msg_namelen > endpoint.capacity())
+                continue;
+            std::memcpy(endpoint.data(), &m_addresses[i], m_messages[i].msg_hdr.msg_namelen);
+            endpoint.resize(m_messages[i].msg_hdr.msg_namelen);
+            f(m_buffers[i].data(), m_messages[i].msg_len, endpoint);
+        }
+        received += static_cast<size_t>(result);
+        if (static_cast<size_t>(result) < maxBatch)
+            break;
+    }
+#else
+    boost::system::error_code error;
+    while (m_socket.available(error) > 0 && !error) {
+        udp::endpoint endpoint;
+        size_t size = m_socket.receive_from(boost::asio::buffer(m_buffers[0]), endpoint, 0, error);
+        if (error == boost::asio::error::message_size)
+            continue;
+        if (error)
+            break;
+        f(m_buffers[0].data(), size, endpoint);
+        ++received;
+    }
+#endif
+    return received;
+}
@@ -0,0 +1,82 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** ArchetypeBenchmark
+*/
+
+#include "ArchetypeRegistry.hpp"
+#include "Position.hpp"
+#include "Velocity.hpp"
+#include "Collider.hpp"
+#include "Collidable.hpp"
+#include "Projectile.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    // Every entity moves and collides; every second one is also a projectile.
+    template <typename World>
+    void populate(World& world, int count)
+    {
+        world.template register_component<Position>();
+        world.template register_component<Velocity>();
+        world.template register_component<Collider>();
+        world.template register_component<Collidable>();
+        world.template register_component<Projectile>();
+        for (int i = 0; i < count; ++i) {
+            auto entity = world.spawn_entity();
+            world.add_component(entity, Position{static_cast<float>(i % 1280), static_cast<float>(i % 720)});
+            world.add_component(entity, Velocity{1.0f, -1.0f});
+            world.add_component(entity, Collider{2.5f, 2.5f});
+            world.add_component(entity, Collidable{i % 3 != 0});
+            if (i % 2 == 0)
+                world.add_component(entity, Projectile{2.0f});
+        }
+    }
+
+    // One Position/Velocity/Projectile/Collider/Collidable query per round.
+    template <typename World>
+    double timeQuery(World& world, int rounds, double& checksum)
+    {
+        auto query = [&world, &checksum]() {
+            world.template view<const Position, const Velocity, const Projectile, const Collider, const Collidable>()
+                .each([&checksum](const Position& pos, const Velocity& vel, const Projectile& proj, const Collider& box, const Collidable& collidable) {
+                    if (collidable.is_collidable)
+                        checksum += pos.x + vel.vx * proj.speed + box.half_width;
+                });
+        };
+        // One untimed round warms the caches.
+        query();
+        checksum = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round)
+            query();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / rounds;
+    }
+}
+
+// Runs the same query on the per-component pools of Registry and on ArchetypeRegistry.
+// Usage: archetype_benchmark [entities] [rounds]
+int main(int argc, char** argv)
+{
+    const int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    Registry pools;
+    populate(pools, count);
+    ArchetypeRegistry archetypes;
+    populate(archetypes, count);
+
+    double poolSum = 0.0;
+    double archetypeSum = 0.0;
+    double poolUs = timeQuery(pools, rounds, poolSum);
+    double archetypeUs = timeQuery(archetypes, rounds, archetypeSum);
+
+    std::printf("%d entities, %d rounds\n", count, rounds);
+    std::printf("pools:      %.1f us/query (checksum %.1f)\n", poolUs, poolSum);
+    std::printf("archetypes: %.1f us/query (checksum %.1f)\n", archetypeUs, archetypeSum);
+    return poolSum == archetypeSum ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** MoveBenchmark
+*/
+
+#include "GeneralEntity.hpp"
+#include "Position.hpp"
+#include "Velocity.hpp"
+#include "Collider.hpp"
+#include "Controllable.hpp"
+#include "Collidable.hpp"
+#include "Projectile.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Times GeneralEntity::move() over entities sharing one registry.
+// Usage: move_benchmark [entities] [rounds]
+int main(int argc, char** argv)
+{
+    const int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    Registry registry;
+    registry.register_component<Position>();
+    registry.register_component<Velocity>();
+    registry.register_component<Collider>();
+    registry.register_component<Controllable>();
+    registry.register_component<Collidable>();
+    registry.register_component<Projectile>();
+
+    std::vector<GeneralEntity> entities;
+    entities.reserve(count);
+    for (int i = 0; i < count; ++i)
+        entities.emplace_back(registry, GeneralEntity::EntityType::Enemy, static_cast<float>(i % 1280), static_cast<float>(i % 720));
+
+    // One untimed round warms the caches.
+    for (auto& entity : entities)
+        entity.move(1.0f, 1.0f);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (auto& entity : entities)
+            entity.move(1.0f, -1.0f);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(count) * rounds);
+    const Position& first = registry.get_components<Position>()[Registry::entity_index(entities.front().getEntity())];
+    std::printf("move(): %d entities, %d rounds, %.2f ns/entity (checksum %.1f)\n", count, rounds, ns, first.x + first.y);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** ArchetypeTests
+*/
+
+#include "Check.hpp"
+#include "ArchetypeRegistry.hpp"
+#include "Position.hpp"
+#include "Velocity.hpp"
+#include "Projectile.hpp"
+#include <map>
+#include <stdexcept>
+
+namespace {
+    using Entity = ArchetypeRegistry::Entity;
+
+    // Slot index to Position x of every entity the view visits.
+    std::map<std::size_t, float> positionsOf(ArchetypeRegistry& world)
+    {
+        std::map<std::size_t, float> seen;
+        world.view<const Position>().each([&seen](std::size_t index, const Position& pos) {
+            CHECK(seen.count(index) == 0);
+            seen[index] = pos.x;
+        });
+        return seen;
+    }
+
+    void moves()
+    {
+        ArchetypeRegistry world;
+        Entity entity = world.spawn_entity();
+        CHECK(world.archetype_count() == 1);
+
+        world.add_component(entity, Position{1.0f, 2.0f});
+        world.add_component(entity, Velocity{3.0f, 4.0f});
+        CHECK(world.archetype_count() == 3);
+        CHECK(world.get_component<Position>(entity).y == 2.0f);
+        CHECK(world.get_component<Velocity>(entity).vx == 3.0f);
+
+        // Adding a component the entity has overwrites it in place.
+        world.add_component(entity, Position{5.0f, 6.0f});
+        CHECK(world.archetype_count() == 3);
+        CHECK(world.get_component<Position>(entity).x == 5.0f);
+
+        world.remove_component<Position>(entity);
+        CHECK(!world.has_component<Position>(entity));
+        CHECK(world.get_component<Velocity>(entity).vy == 4.0f);
+        CHECK(world.archetype_count() == 4);
+        CHECK(positionsOf(world).empty());
+
+        // Going back reuses the archetypes already made.
+        world.add_component(entity, Position{7.0f, 8.0f});
+        CHECK(world.archetype_count() == 4);
+        CHECK(world.get_component<Velocity>(entity).vx == 3.0f);
+        CHECK(positionsOf(world) == (std::map<std::size_t, float>{{0, 7.0f}}));
+
+        // Removing what the entity lacks does not move it.
+        world.remove_component<Projectile>(entity);
+        CHECK(world.archetype_count() == 4);
+        CHECK_THROWS(world.get_component<Projectile>(entity), std::out_of_range);
+    }
+
+    void rowFixups()
+    {
+        ArchetypeRegistry world;
+        Entity entities[4];
+        for (int i = 0; i < 4; ++i) {
+            entities[i] = world.spawn_entity();
+            world.add_component(entities[i], Position{10.0f * i, 0.0f});
+            world.add_component(entities[i], Velocity{static_cast<float>(i), 0.0f});
+        }
+
+        // The last row fills the killed first one.
+        world.kill_entity(entities[0]);
+        CHECK(world.get_component<Position>(entities[3]).x == 30.0f);
+        CHECK(world.get_component<Velocity>(entities[3]).vx == 3.0f);
+        world.get_component<Position>(entities[3]).x = 35.0f;
+        CHECK(positionsOf(world) == (std::map<std::size_t, float>{{1, 10.0f}, {2, 20.0f}, {3, 35.0f}}));
+
+        // The row left by a moved entity is filled the same way.
+        world.remove_component<Velocity>(entities[1]);
+        CHECK(world.get_component<Position>(entities[1]).x == 10.0f);
+        world.get_component<Velocity>(entities[2]).vy = 1.0f;
+        CHECK(world.get_component<Position>(entities[2]).x == 20.0f);
+        CHECK(world.get_component<Velocity>(entities[2]).vx == 2.0f);
+        CHECK(world.get_component<Velocity>(entities[3]).vx == 3.0f);
+        world.view<const Velocity>().each([&entities](std::size_t index, const Velocity& vel) {
+            CHECK(vel.vy == (index == ArchetypeRegistry::entity_index(entities[2]) ? 1.0f : 0.0f));
+        });
+        CHECK(positionsOf(world) == (std::map<std::size_t, float>{{1, 10.0f}, {2, 20.0f}, {3, 35.0f}}));
+
+        world.kill_entity(entities[3]);
+        world.kill_entity(entities[2]);
+        CHECK(positionsOf(world) == (std::map<std::size_t, float>{{1, 10.0f}}));
+    }
+
+    void generations()
+    {
+        ArchetypeRegistry world;
+        Entity first = world.spawn_entity();
+        Entity kept = world.spawn_entity();
+        world.add_component(first, Position{1.0f, 1.0f});
+        world.add_component(kept, Position{2.0f, 2.0f});
+        world.kill_entity(first);
+        CHECK(!world.entity_exists(first));
+
+        Entity respawned = world.spawn_entity();
+        CHECK(ArchetypeRegistry::entity_index(respawned) == ArchetypeRegistry::entity_index(first));
+        CHECK(ArchetypeRegistry::entity_generation(respawned) == ArchetypeRegistry::entity_generation(first) + 1);
+        CHECK(world.entity_from_index(ArchetypeRegistry::entity_index(first)) == respawned);
+
+        // The stale handle reaches neither the new entity nor its components.
+        CHECK(!world.entity_exists(first));
+        CHECK(!world.has_component<Position>(respawned));
+        world.add_component(respawned, Position{3.0f, 3.0f});
+        CHECK(!world.has_component<Position>(first));
+        CHECK_THROWS(world.get_component<Position>(first), std::out_of_range);
+        CHECK_THROWS(world.add_component(first, Velocity{}), std::out_of_range);
+        world.kill_entity(first);
+        world.remove_component<Position>(first);
+        CHECK(world.get_component<Position>(respawned).x == 3.0f);
+
+        // Deferred kills wait for the flush.
+        world.commands().kill(kept);
+        CHECK(world.entity_exists(kept));
+        world.flush_commands();
+        CHECK(!world.entity_exists(kept));
+        CHECK(positionsOf(world) == (std::map<std::size_t, float>{{0, 3.0f}}));
+    }
+}
+
+int main()
+{
+    moves();
+    rowFixups();
+    generations();
+    return checkFailures() == 0 ? 0 : 1;
+}
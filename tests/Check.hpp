@@ -0,0 +1,41 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** Check
+*/
+
+#pragma once
+
+#include <iostream>
+
+// Failures of the test program so far; main() returns it.
+inline int& checkFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+// Reports a false condition with its location and goes on.
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl; \
+            ++checkFailures(); \
+        } \
+    } while (0)
+
+// Checks that the statement throws an exception of the given type.
+#define CHECK_THROWS(statement, exception) \
+    do { \
+        bool thrown = false; \
+        try { \
+            statement; \
+        } catch (const exception&) { \
+            thrown = true; \
+        } \
+        if (!thrown) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #statement " did not throw " #exception << std::endl; \
+            ++checkFailures(); \
+        } \
+    } while (0)
@@ -0,0 +1,160 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** CodecTests
+*/
+
+#include "Check.hpp"
+#include "Codec.hpp"
+#include "DataPacking.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using Network::LzCodec;
+using Network::RawCodec;
+
+namespace {
+    using Bytes = std::vector<uint8_t>;
+
+    // Compresses then decompresses with the same codec.
+    bool roundTrips(Network::Codec& codec, const Bytes& input, size_t* packedSize = nullptr)
+    {
+        Bytes packed(codec.compressBound(input.size()));
+        size_t size = codec.compress(input.data(), input.size(), packed.data(), packed.size());
+        if (size == 0 && !input.empty())
+            return false;
+        if (packedSize)
+            *packedSize = size;
+        Bytes unpacked(input.size() + 1);
+        size_t unpackedSize = codec.decompress(packed.data(), size, unpacked.data(), unpacked.size());
+        unpacked.resize(unpackedSize);
+        return unpacked == input;
+    }
+
+    Bytes controlDatagram(Network::PacketType type)
+    {
+        Network::EntityRecord record{type, -1, -1.0f, -1.0f};
+        Bytes datagram(Network::Wire::encodedSize(1));
+        Network::Wire::encode(datagram.data(), datagram.size(), type, 0, &record, 1);
+        return datagram;
+    }
+
+    Bytes randomBytes(size_t size, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        Bytes bytes(size);
+        for (auto& byte : bytes)
+            byte = static_cast<uint8_t>(rng());
+        return bytes;
+    }
+
+    void withDictionary()
+    {
+        LzCodec codec;
+        size_t packed = 0;
+        Bytes started = controlDatagram(Network::PacketType::GAME_STARTED);
+        CHECK(roundTrips(codec, started, &packed));
+        // The whole datagram is in the dictionary.
+        CHECK(packed < started.size() / 2);
+
+        CHECK(roundTrips(codec, {}));
+        CHECK(roundTrips(codec, Bytes(1, 42)));
+        CHECK(roundTrips(codec, randomBytes(9, 1)));
+        CHECK(roundTrips(codec, randomBytes(3000, 2)));
+        // Long literal runs and long matches use the extra length bytes.
+        Bytes repeated(2000, 7);
+        CHECK(roundTrips(codec, repeated, &packed));
+        CHECK(packed < 32);
+    }
+
+    void withoutDictionary()
+    {
+        LzCodec codec(Bytes{});
+        size_t packed = 0;
+        Bytes pattern;
+        for (int i = 0; i < 400; ++i)
+            pattern.push_back(static_cast<uint8_t>(i % 13));
+        CHECK(roundTrips(codec, pattern, &packed));
+        CHECK(packed < pattern.size() / 4);
+        CHECK(roundTrips(codec, randomBytes(500, 3)));
+        CHECK(roundTrips(codec, controlDatagram(Network::PacketType::LATENCY_CHECK)));
+
+        // A match reaching before the output is malformed without a dictionary.
+        LzCodec primed;
+        Bytes started = controlDatagram(Network::PacketType::GAME_STARTED);
+        Bytes packedStarted(primed.compressBound(started.size()));
+        size_t size = primed.compress(started.data(), started.size(), packedStarted.data(), packedStarted.size());
+        Bytes out(started.size());
+        CHECK(codec.decompress(packedStarted.data(), size, out.data(), out.size()) == 0);
+    }
+
+    void malformedInput()
+    {
+        LzCodec codec;
+        Bytes input = randomBytes(200, 4);
+        input.insert(input.end(), 100, 9);
+        Bytes packed(codec.compressBound(input.size()));
+        size_t size = codec.compress(input.data(), input.size(), packed.data(), packed.size());
+        CHECK(size > 0);
+        Bytes out(input.size());
+
+        // Output buffers too small on either side.
+        Bytes small(size / 2);
+        CHECK(codec.compress(input.data(), input.size(), small.data(), small.size()) == 0);
+        CHECK(codec.decompress(packed.data(), size, out.data(), out.size() - 1) == 0);
+
+        // Every truncation either fails or decodes a prefix of the input.
+        for (size_t cut = 0; cut < size; ++cut) {
+            size_t got = codec.decompress(packed.data(), cut, out.data(), out.size());
+            CHECK(got <= input.size() && std::equal(out.begin(), out.begin() + got, input.begin()));
+        }
+
+        // Zero offset, and literal count past the end.
+        const uint8_t zeroOffset[] = {0x10, 'a', 0x00, 0x00};
+        CHECK(codec.decompress(zeroOffset, sizeof(zeroOffset), out.data(), out.size()) == 0);
+        const uint8_t overrun[] = {0x50, 'a', 'b'};
+        CHECK(codec.decompress(overrun, sizeof(overrun), out.data(), out.size()) == 0);
+        const uint8_t missingLength[] = {0xf0, 0xff};
+        CHECK(codec.decompress(missingLength, sizeof(missingLength), out.data(), out.size()) == 0);
+
+        RawCodec raw;
+        CHECK(roundTrips(raw, input));
+        CHECK(raw.compress(input.data(), input.size(), small.data(), small.size()) == 0);
+    }
+
+    void packing()
+    {
+        std::string shortDatagram = "ping";
+        std::string packed = DataPacking::compressData(shortDatagram);
+        CHECK(packed.size() == shortDatagram.size() + 1 && packed[0] == static_cast<char>(Network::CodecId::Raw));
+        CHECK(DataPacking::decompressData(packed) == shortDatagram);
+
+        Network::EntityRecord background[] = {
+            {Network::PacketType::CREATE_BACKGROUND, -100, 0.0f, 0.0f},
+            {Network::PacketType::IMPORTANT_PACKET, -1, -1.0f, -1.0f},
+        };
+        std::string datagram(Network::Wire::encodedSize(2), '\0');
+        Network::Wire::encode(reinterpret_cast<uint8_t*>(datagram.data()), datagram.size(), Network::PacketType::FRAME, 12, background, 2);
+        packed = DataPacking::compressData(datagram);
+        CHECK(packed[0] == static_cast<char>(Network::CodecId::Lz) && packed.size() < datagram.size());
+        CHECK(DataPacking::decompressData(packed) == datagram);
+
+        // Unknown codec tags and empty datagrams unpack to nothing.
+        packed[0] = static_cast<char>(0x7f);
+        CHECK(DataPacking::decompressData(packed).empty());
+        CHECK(DataPacking::decompressData("").empty());
+    }
+}
+
+int main()
+{
+    withDictionary();
+    withoutDictionary();
+    malformedInput();
+    packing();
+    return checkFailures() == 0 ? 0 : 1;
+}
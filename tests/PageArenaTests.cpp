@@ -0,0 +1,73 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** PageArenaTests
+*/
+
+#include "Check.hpp"
+#include "PageArena.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+    const std::size_t pageBytes = page_arena::block_size / 16;
+
+    std::vector<void*> allocatePages(page_arena& arena, std::size_t count)
+    {
+        std::vector<void*> pages;
+        for (std::size_t i = 0; i < count; ++i) {
+            pages.push_back(arena.allocate(pageBytes));
+            CHECK(reinterpret_cast<std::uintptr_t>(pages.back()) % page_arena::alignment == 0);
+            std::memset(pages.back(), static_cast<int>(i), pageBytes);
+        }
+        return pages;
+    }
+
+    void releasedBlocks()
+    {
+        page_arena arena;
+        std::vector<void*> first = allocatePages(arena, 16);
+        std::vector<void*> second = allocatePages(arena, 16);
+        CHECK(arena.block_count() == 2);
+
+        // A released page is reused while its block still has live pages.
+        arena.deallocate(first[3], pageBytes);
+        CHECK(arena.allocate(pageBytes) == first[3]);
+
+        // The first block goes back to the heap with its last page.
+        for (void* page : first)
+            arena.deallocate(page, pageBytes);
+        CHECK(arena.block_count() == 1);
+
+        // The block pages are carved from is rewound instead.
+        for (void* page : second)
+            arena.deallocate(page, pageBytes);
+        CHECK(arena.block_count() == 1);
+        std::vector<void*> again = allocatePages(arena, 16);
+        CHECK(again == second);
+        CHECK(arena.block_count() == 1);
+    }
+
+    void largePages()
+    {
+        page_arena arena;
+        void* small = arena.allocate(pageBytes);
+        void* large = arena.allocate(3 * page_arena::block_size);
+        std::memset(large, 1, 3 * page_arena::block_size);
+        CHECK(arena.block_count() == 2);
+
+        // Pages keep being carved from the current block.
+        CHECK(arena.allocate(pageBytes) == static_cast<std::byte*>(small) + pageBytes);
+        arena.deallocate(large, 3 * page_arena::block_size);
+        CHECK(arena.block_count() == 1);
+    }
+}
+
+int main()
+{
+    releasedBlocks();
+    largePages();
+    return checkFailures() == 0 ? 0 : 1;
+}
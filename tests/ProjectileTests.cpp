@@ -0,0 +1,100 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** ProjectileTests
+*/
+
+#include "Check.hpp"
+#include "ProjectileSystem.hpp"
+#include "Controllable.hpp"
+#include <cstdint>
+
+namespace {
+    struct World {
+        explicit World(bool grouped)
+        {
+            registry.register_component<Position>();
+            registry.register_component<Velocity>();
+            registry.register_component<Projectile>();
+            registry.register_component<Collider>();
+            registry.register_component<Collidable>();
+            registry.register_component<Controllable>();
+            if (grouped)
+                registry.group<Position, Velocity, Projectile>();
+        }
+
+        Registry::Entity target(float x, float y, std::uint32_t layer, std::uint32_t mask, bool collidable = true)
+        {
+            Registry::Entity entity = registry.spawn_entity();
+            registry.add_component<Position>(entity, {x, y});
+            registry.add_component<Collider>(entity, {2.5f, 2.5f, layer, mask});
+            registry.add_component<Collidable>(entity, {collidable});
+            return entity;
+        }
+
+        Registry::Entity projectile(float x, float y, std::uint32_t layer, std::uint32_t mask)
+        {
+            Registry::Entity entity = target(x, y, layer, mask);
+            registry.add_component<Velocity>(entity, {1.0f, 0.0f});
+            registry.add_component<Projectile>(entity, {2.0f});
+            return entity;
+        }
+
+        void step()
+        {
+            projectile_system(registry, registry.get_components<Position>(), registry.get_components<Velocity>(),
+                registry.get_components<Projectile>(), registry.get_components<Collider>(), registry.get_components<Collidable>());
+            registry.flush_commands();
+        }
+
+        float x(Registry::Entity entity) { return registry.get_component<Position>(entity).x; }
+
+        Registry registry;
+    };
+
+    void movement(bool grouped)
+    {
+        World world(grouped);
+        Registry::Entity bullet = world.projectile(100.0f, 0.0f, 1, 2);
+        // No collider: moved all the same, and never hit.
+        Registry::Entity bare = world.registry.spawn_entity();
+        world.registry.add_component<Position>(bare, {300.0f, 0.0f});
+        world.registry.add_component<Velocity>(bare, {-1.0f, 0.0f});
+        world.registry.add_component<Projectile>(bare, {1.0f});
+        Registry::Entity edge = world.projectile(799.0f, 500.0f, 1, 2);
+
+        world.step();
+        CHECK(world.x(bullet) == 102.0f);
+        CHECK(world.x(bare) == 299.0f);
+        CHECK(!world.registry.entity_exists(edge));
+    }
+
+    void hits()
+    {
+        World world(true);
+        Registry::Entity bullet = world.projectile(100.0f, 100.0f, 1, 2);
+        Registry::Entity first = world.target(102.0f, 100.0f, 2, 1);
+        Registry::Entity second = world.target(102.0f, 101.0f, 2, 1);
+        // Layers that do not match, or a target that is not collidable.
+        Registry::Entity friendly = world.projectile(300.0f, 300.0f, 1, 2);
+        Registry::Entity ally = world.target(302.0f, 300.0f, 1, 1);
+        Registry::Entity ghost = world.projectile(500.0f, 500.0f, 1, 2);
+        Registry::Entity wall = world.target(502.0f, 500.0f, 2, 1, false);
+
+        world.step();
+        CHECK(!world.registry.entity_exists(bullet));
+        // One target per projectile.
+        CHECK(world.registry.entity_exists(first) != world.registry.entity_exists(second));
+        CHECK(world.registry.entity_exists(friendly) && world.registry.entity_exists(ally));
+        CHECK(world.registry.entity_exists(ghost) && world.registry.entity_exists(wall));
+    }
+}
+
+int main()
+{
+    movement(true);
+    movement(false);
+    hits();
+    return checkFailures() == 0 ? 0 : 1;
+}
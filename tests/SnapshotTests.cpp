@@ -0,0 +1,188 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** SnapshotTests
+*/
+
+#include "Check.hpp"
+#include "Registry.hpp"
+#include "Position.hpp"
+#include "Velocity.hpp"
+#include "Controllable.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    void registerComponents(Registry& registry)
+    {
+        registry.register_component<Position>();
+        registry.register_component<Velocity>();
+        registry.register_component<Controllable>();
+    }
+
+    // Entities 0 to 4, entity 2 killed so its slot is free, dense and sparse pools.
+    std::vector<std::byte> sampleSnapshot()
+    {
+        Registry registry;
+        registerComponents(registry);
+        for (int i = 0; i < 5; ++i) {
+            Registry::Entity entity = registry.spawn_entity();
+            registry.add_component<Position>(entity, {10.0f * i, 20.0f * i});
+            if (i % 2 == 0)
+                registry.add_component<Velocity>(entity, {1.0f, -1.0f});
+            if (i == 3)
+                registry.add_component<Controllable>(entity, {});
+        }
+        registry.kill_entity(registry.entity_from_index(2));
+        return registry.snapshot();
+    }
+
+    void roundTrip()
+    {
+        Registry registry;
+        registerComponents(registry);
+        registry.restore(sampleSnapshot());
+
+        const auto& positions = registry.get_components<Position>();
+        const auto& velocities = registry.get_components<Velocity>();
+        const auto& controllables = registry.get_components<Controllable>();
+        CHECK(positions.size() == 4);
+        CHECK(!positions.contains(2));
+        CHECK(positions.contains(4) && positions[4].x == 40.0f && positions[4].y == 80.0f);
+        CHECK(velocities.size() == 2);
+        CHECK(velocities.contains(0) && velocities.contains(4) && !velocities.contains(2));
+        CHECK(controllables.size() > 3 && controllables[3].has_value());
+        CHECK(!registry.entity_exists(registry.entity_from_index(2)));
+        CHECK(registry.entity_exists(registry.entity_from_index(3)));
+
+        // The freed slot is the next one reused.
+        Registry::Entity spawned = registry.spawn_entity();
+        CHECK(Registry::entity_index(spawned) == 2);
+        CHECK(registry.snapshot().size() > 0);
+    }
+
+    void truncatedBuffer()
+    {
+        std::vector<std::byte> buffer = sampleSnapshot();
+        for (std::size_t size = 0; size < buffer.size(); ++size) {
+            Registry registry;
+            registerComponents(registry);
+            std::vector<std::byte> truncated(buffer.begin(), buffer.begin() + size);
+            CHECK_THROWS(registry.restore(truncated), std::runtime_error);
+        }
+    }
+
+    void foreignBuffer()
+    {
+        std::vector<std::byte> buffer = sampleSnapshot();
+        buffer[0] = std::byte{0};
+        Registry registry;
+        registerComponents(registry);
+        CHECK_THROWS(registry.restore(buffer), std::runtime_error);
+
+        // Pools must be registered with the same types as when saved.
+        Registry other;
+        other.register_component<Velocity>();
+        CHECK_THROWS(other.restore(sampleSnapshot()), std::runtime_error);
+    }
+
+    // Overwrites the bytes of value at offset.
+    template <typename T>
+    void patch(std::vector<std::byte>& buffer, std::size_t offset, T value)
+    {
+        std::memcpy(buffer.data() + offset, &value, sizeof(value));
+    }
+
+    void corruptedCounts()
+    {
+        // Layout of sampleSnapshot(): magic, version, slot count, 5 slots of
+        // generation and live flag, dead count, the dead slot 2, pools.
+        const std::size_t slotCountAt = 8;
+        const std::size_t deadCountAt = slotCountAt + 8 + 5 * 5;
+        const std::size_t deadAt = deadCountAt + 8;
+
+        Registry registry;
+        registerComponents(registry);
+        registry.restore(sampleSnapshot());
+
+        for (std::size_t offset : {slotCountAt, deadCountAt}) {
+            for (std::uint64_t count : {std::uint64_t(1) << 61, ~std::uint64_t(0)}) {
+                std::vector<std::byte> buffer = sampleSnapshot();
+                patch(buffer, offset, count);
+                CHECK_THROWS(registry.restore(buffer), std::runtime_error);
+            }
+        }
+
+        // Free slots out of range or alive would be handed out by spawn_entity().
+        for (std::size_t index : {std::size_t(5), std::size_t(1000000), std::size_t(3)}) {
+            std::vector<std::byte> buffer = sampleSnapshot();
+            patch(buffer, deadAt, index);
+            CHECK_THROWS(registry.restore(buffer), std::runtime_error);
+        }
+        // Those are caught before the registry is touched.
+        CHECK(registry.get_components<Position>().size() == 4);
+    }
+
+    void corruptedPools()
+    {
+        std::vector<bool> alive = {true, true, false, true};
+
+        auto densePool = [](std::uint64_t count, std::vector<std::size_t> entities) {
+            std::vector<std::byte> buffer;
+            snapshot_writer out(buffer);
+            out.write(count);
+            for (std::size_t entity : entities)
+                out.write(entity);
+            for (std::size_t i = 0; i < entities.size(); ++i)
+                out.write(Position{1.0f, 2.0f * i});
+            return buffer;
+        };
+        auto loadDense = [&alive](const std::vector<std::byte>& buffer, dense_array<Position>& pool) {
+            snapshot_reader in(buffer.data(), buffer.size());
+            ecs_detail::load_pool(in, pool, alive);
+            return in.done();
+        };
+
+        dense_array<Position> dense;
+        CHECK(loadDense(densePool(2, {0, 3}), dense));
+        CHECK(dense.size() == 2 && dense.contains(3) && dense[3].y == 2.0f);
+
+        // Counts whose byte size wraps around, owners unknown, dead or twice.
+        dense_array<Position> rejected;
+        CHECK_THROWS(loadDense(densePool(std::uint64_t(1) << 61, {0}), rejected), std::runtime_error);
+        CHECK_THROWS(loadDense(densePool(1, {7}), rejected), std::runtime_error);
+        CHECK_THROWS(loadDense(densePool(1, {2}), rejected), std::runtime_error);
+        CHECK_THROWS(loadDense(densePool(2, {1, 1}), rejected), std::runtime_error);
+        CHECK(rejected.empty());
+
+        auto loadSparse = [&alive](std::uint64_t count, std::vector<std::uint64_t> entities) {
+            std::vector<std::byte> buffer;
+            snapshot_writer out(buffer);
+            out.write(count);
+            for (std::uint64_t entity : entities) {
+                out.write(entity);
+                out.write(Controllable{});
+            }
+            sparse_array<Controllable> pool;
+            snapshot_reader in(buffer.data(), buffer.size());
+            ecs_detail::load_pool(in, pool, alive);
+        };
+        loadSparse(1, {3});
+        CHECK_THROWS(loadSparse(~std::uint64_t(0), {3}), std::runtime_error);
+        CHECK_THROWS(loadSparse(1, {9}), std::runtime_error);
+        CHECK_THROWS(loadSparse(1, {2}), std::runtime_error);
+        CHECK_THROWS(loadSparse(2, {0, 0}), std::runtime_error);
+    }
+}
+
+int main()
+{
+    roundTrip();
+    truncatedBuffer();
+    foreignBuffer();
+    corruptedCounts();
+    corruptedPools();
+    return checkFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type [WSL: Ubuntu]
+** File description:
+** WireTests
+*/
+
+#include "Check.hpp"
+#include "BitPacking.hpp"
+#include "WireProtocol.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace Network;
+
+namespace {
+    using Bytes = std::vector<uint8_t>;
+
+    void bits()
+    {
+        Bytes buffer(64);
+        BitWriter writer(buffer.data(), buffer.size());
+        writer.write(5, 3);
+        writer.write(0xabcd, 16);
+        writer.write(UINT32_MAX, 32);
+        for (uint32_t value : {0u, 1u, 2u, 1000u, UINT32_MAX - 1})
+            writer.writeGamma(value);
+        for (int32_t value : {0, -1, 1, -70000, INT32_MIN + 1, INT32_MAX})
+            writer.writeSigned(value);
+        CHECK(!writer.overflowed());
+
+        BitReader reader(buffer.data(), writer.bytes());
+        CHECK(reader.read(3) == 5);
+        CHECK(reader.read(16) == 0xabcd);
+        CHECK(reader.read(32) == UINT32_MAX);
+        for (uint32_t value : {0u, 1u, 2u, 1000u, UINT32_MAX - 1})
+            CHECK(reader.readGamma() == value);
+        for (int32_t value : {0, -1, 1, -70000, INT32_MIN + 1, INT32_MAX})
+            CHECK(reader.readSigned() == value);
+        CHECK(!reader.failed());
+
+        // Reading past the end fails and returns zeros.
+        CHECK(reader.read(16) == 0);
+        CHECK(reader.failed());
+
+        BitWriter small(buffer.data(), 1);
+        small.write(0, 9);
+        CHECK(small.overflowed());
+
+        // More leading zeros than any 32-bit value has.
+        Bytes zeros(8, 0);
+        BitReader gamma(zeros.data(), zeros.size());
+        CHECK(gamma.readGamma() == 0);
+        CHECK(gamma.failed());
+    }
+
+    void header()
+    {
+        EntityRecord records[] = {
+            {PacketType::CREATE_BACKGROUND, -100, 0.0f, 0.0f},
+            {PacketType::WIN, 7, 1.5f, -2.25f},
+        };
+        Bytes datagram(Wire::encodedSize(2));
+        CHECK(Wire::encode(datagram.data(), datagram.size(), PacketType::FRAME, 42, records, 2) == datagram.size());
+        CHECK(Wire::encode(datagram.data(), datagram.size() - 1, PacketType::FRAME, 42, records, 2) == 0);
+
+        Wire::Header decoded{};
+        CHECK(Wire::decodeHeader(datagram.data(), datagram.size(), decoded));
+        CHECK(decoded.version == Wire::version && decoded.type == PacketType::FRAME);
+        CHECK(decoded.count == 2 && decoded.frameId == 42 && decoded.baselineId == Wire::noBaseline);
+        CHECK(!Wire::hasEntities(decoded));
+        EntityRecord win = Wire::decodeRecord(datagram.data(), 1);
+        CHECK(win.type == PacketType::WIN && win.id == 7 && win.x == 1.5f && win.y == -2.25f);
+        CHECK(Wire::decodeRecord(datagram.data(), 0).id == -100);
+
+        // Short, longer or shorter than announced, or of another version.
+        CHECK(!Wire::decodeHeader(datagram.data(), Wire::headerSize - 1, decoded));
+        CHECK(!Wire::decodeHeader(datagram.data(), datagram.size() - 1, decoded));
+        Bytes longer = datagram;
+        longer.push_back(0);
+        CHECK(!Wire::decodeHeader(longer.data(), longer.size(), decoded));
+        Bytes old = datagram;
+        old[0] = Wire::version - 1;
+        CHECK(!Wire::decodeHeader(old.data(), old.size(), decoded));
+        Bytes tooManyRecords = datagram;
+        tooManyRecords[2] = 3;
+        CHECK(!Wire::decodeHeader(tooManyRecords.data(), tooManyRecords.size(), decoded));
+    }
+
+    // Frame with the entity block of current against baseline; empty when it does not fit.
+    Bytes encodeEntities(const std::vector<EntityState>& current, const std::vector<EntityState>& baseline, uint32_t baselineId,
+        const PositionQuantiser& quantiser, size_t capacity = 0)
+    {
+        Bytes datagram(capacity ? capacity : Wire::encodedSize(0) + Wire::entityBlockBound(current.size(), baseline.size()));
+        size_t size = Wire::encode(datagram.data(), datagram.size(), PacketType::FRAME, 9, nullptr, 0);
+        size = Wire::appendEntities(datagram.data(), size, datagram.size(), quantiser, baselineId,
+            current.data(), current.size(), baseline.data(), baseline.size());
+        datagram.resize(size);
+        return datagram;
+    }
+
+    // Applies the entity block to baseline, like a client does.
+    bool decodeEntities(const Bytes& datagram, const std::vector<EntityState>& baseline, std::vector<EntityState>& state)
+    {
+        Wire::Header header{};
+        if (!Wire::decodeHeader(datagram.data(), datagram.size(), header) || !Wire::hasEntities(header))
+            return false;
+        state = header.baselineId == Wire::noBaseline ? std::vector<EntityState>() : baseline;
+        PositionQuantiser quantiser;
+        return Wire::decodeEntities(datagram.data(), header, baseline.data(), baseline.size(), quantiser,
+            [&state](EntityChange change, const EntityState& entity) {
+                auto it = state.begin();
+                while (it != state.end() && it->id < entity.id)
+                    ++it;
+                bool present = it != state.end() && it->id == entity.id;
+                if (change == EntityChange::Removed)
+                    state.erase(it);
+                else if (present)
+                    *it = entity;
+                else
+                    state.insert(it, entity);
+            });
+    }
+
+    void entityBlock()
+    {
+        PositionQuantiser quantiser;
+        quantiser.bits = 12;
+        std::vector<EntityState> baseline = {
+            {1, PacketType::CREATE_PLAYER, 100, 100},
+            {2, PacketType::CREATE_ENEMY, 4000, 10},
+            {5, PacketType::CREATE_BULLET, 50, 60},
+            {9, PacketType::CREATE_ENEMY, 700, 700},
+        };
+        std::vector<EntityState> current = {
+            {1, PacketType::CREATE_PLAYER, 102, 99},      // small move
+            {2, PacketType::CREATE_ENEMY, 10, 4000},      // large move
+            {5, PacketType::CREATE_ENEMY_BULLET, 50, 60}, // recycled slot
+            {6, PacketType::CREATE_BULLET, 4095, 0},      // spawned
+                                                          // 9 removed
+        };
+
+        std::vector<EntityState> state;
+        Bytes delta = encodeEntities(current, baseline, 3, quantiser);
+        CHECK(!delta.empty());
+        CHECK(decodeEntities(delta, baseline, state) && state == current);
+
+        Bytes full = encodeEntities(current, baseline, Wire::noBaseline, quantiser);
+        CHECK(!full.empty());
+        CHECK(decodeEntities(full, {}, state) && state == current);
+
+        // Only what differs is sent.
+        Bytes unchanged = encodeEntities(baseline, baseline, 3, quantiser);
+        CHECK(decodeEntities(unchanged, baseline, state) && state == baseline);
+        CHECK(unchanged.size() < delta.size());
+
+        CHECK(encodeEntities(current, baseline, 3, quantiser, Wire::headerSize + 4).empty());
+    }
+
+    void malformedEntityBlock()
+    {
+        PositionQuantiser quantiser;
+        std::vector<EntityState> baseline = {{4, PacketType::CREATE_ENEMY, 10, 10}};
+        std::vector<EntityState> current = {{4, PacketType::CREATE_ENEMY, 12, 8}};
+        Bytes delta = encodeEntities(current, baseline, 3, quantiser);
+        std::vector<EntityState> state;
+
+        // The receiver lost the baseline entity the move is relative to.
+        CHECK(!decodeEntities(delta, {}, state));
+
+        // A block cut short, with the header length patched to match.
+        Wire::Header header{};
+        CHECK(Wire::decodeHeader(delta.data(), delta.size(), header));
+        Bytes cut(delta.begin(), delta.begin() + Wire::headerSize + 2);
+        Wire::detail::put32(cut.data() + 12, 2);
+        CHECK(Wire::decodeHeader(cut.data(), cut.size(), header));
+        size_t reported = 0;
+        CHECK(!Wire::decodeEntities(cut.data(), header, baseline.data(), baseline.size(), quantiser,
+            [&reported](EntityChange, const EntityState&) { ++reported; }));
+        CHECK(reported == 0);
+    }
+}
+
+int main()
+{
+    bits();
+    header();
+    entityBlock();
+    malformedEntityBlock();
+    return checkFailures() == 0 ? 0 : 1;
+}